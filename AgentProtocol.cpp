@@ -0,0 +1,93 @@
+#include "AgentProtocol.h"
+#include <cstring>
+
+static void putU16(std::vector<std::uint8_t>& out, std::uint16_t v) {
+    out.push_back(static_cast<std::uint8_t>(v));
+    out.push_back(static_cast<std::uint8_t>(v >> 8));
+}
+static void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+static void putF32(std::vector<std::uint8_t>& out, float f) {
+    std::uint32_t v;
+    std::memcpy(&v, &f, 4);
+    putU32(out, v);
+}
+static std::uint64_t getLE(const std::uint8_t* p, int n) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < n; ++i) v |= static_cast<std::uint64_t>(p[i]) << (8 * i);
+    return v;
+}
+static float getF32(const std::uint8_t* p) {
+    std::uint32_t v = static_cast<std::uint32_t>(getLE(p, 4));
+    float f;
+    std::memcpy(&f, &v, 4);
+    return f;
+}
+
+// ─── Requests ─────────────────────────────────────────────────────────────
+AgentParse parseAgentRequest(const std::uint8_t*& p, const std::uint8_t* end, AgentRequest& out) {
+    if (p == end) return AgentParse::INCOMPLETE;
+    const std::size_t left = static_cast<std::size_t>(end - p);
+    out = AgentRequest{ static_cast<AgentOp>(p[0]), 0, 0, 0 };
+    switch (p[0]) {
+        case AGENT_RESET:
+            if (left < 9) return AgentParse::INCOMPLETE;
+            out.seed = getLE(p + 1, 8);
+            p += 9;
+            return AgentParse::OK;
+        case AGENT_STEP:
+            if (left < 2) return AgentParse::INCOMPLETE;
+            out.action = p[1];
+            p += 2;
+            return AgentParse::OK;
+        case AGENT_BATCH:
+            if (left < 3) return AgentParse::INCOMPLETE;
+            out.count = static_cast<std::uint16_t>(getLE(p + 1, 2));
+            p += 3;
+            return AgentParse::OK;
+        case AGENT_OBSERVE:
+            p += 1;
+            return AgentParse::OK;
+        default:
+            return AgentParse::BAD_OPCODE;
+    }
+}
+
+void putAgentReset(std::vector<std::uint8_t>& out, std::uint64_t seed) {
+    out.push_back(AGENT_RESET);
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(seed >> (8 * i)));
+}
+
+void putAgentStep(std::vector<std::uint8_t>& out, bool flap) {
+    out.push_back(AGENT_STEP);
+    out.push_back(flap ? 1 : 0);
+}
+
+void putAgentBatch(std::vector<std::uint8_t>& out, const std::uint8_t* actions, std::uint16_t n) {
+    out.push_back(AGENT_BATCH);
+    putU16(out, n);
+    out.insert(out.end(), actions, actions + n);
+}
+
+void putAgentObserve(std::vector<std::uint8_t>& out) { out.push_back(AGENT_OBSERVE); }
+
+// ─── Replies ──────────────────────────────────────────────────────────────
+void putAgentState(std::vector<std::uint8_t>& out, const AgentState& s) {
+    for (int i = 0; i < SIM_OBS_SIZE; ++i) putF32(out, s.obs[i]);
+    putF32(out, s.reward);
+    putU32(out, static_cast<std::uint32_t>(s.score));
+    putU32(out, s.tick);
+    out.push_back(s.done);
+}
+
+AgentState readAgentState(const std::uint8_t* p) {
+    AgentState s;
+    for (int i = 0; i < SIM_OBS_SIZE; ++i) s.obs[i] = getF32(p + 4 * i);
+    p += 4 * SIM_OBS_SIZE;
+    s.reward = getF32(p);
+    s.score  = static_cast<std::int32_t>(static_cast<std::uint32_t>(getLE(p + 4, 4)));
+    s.tick   = static_cast<std::uint32_t>(getLE(p + 8, 4));
+    s.done   = p[12];
+    return s;
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "SimWorld.h"
+
+// ─── Agent control protocol ───────────────────────────────────────────────
+// Compact binary messages over one local TCP stream, little-endian.
+//
+// Requests (client to server):
+//   'R' u64 seed            restart on this course          -> one record
+//   'S' u8 action           one tick, flap if action != 0   -> one record
+//   'B' u16 n, n x u8       n ticks, one action each        -> one batch
+//   'O'                     current state, no tick          -> one record
+// Replies (server to client), in request order:
+//   record:  'r' STATE
+//   batch:   'b' u16 n, then n STATEs (one per tick)
+//   error:   'e' u8 opcode; the server then drops the connection
+// STATE (STATE_SIZE bytes):
+//   f32 x SIM_OBS_SIZE (see SimWorld::observe), f32 reward,
+//   i32 score, u32 tick, u8 done
+//
+// Rewards are +1 per pipe and -1 on death; done is set from the tick the
+// bird dies, and later steps return done again with reward 0 until a
+// reset. A client may send any number of requests without waiting; the
+// server answers everything it has read in one write, so pipelined steps
+// come back as batched observations.
+
+enum AgentOp : std::uint8_t {
+    AGENT_RESET   = 'R',
+    AGENT_STEP    = 'S',
+    AGENT_BATCH   = 'B',
+    AGENT_OBSERVE = 'O',
+
+    AGENT_RECORD  = 'r',
+    AGENT_REPLY_BATCH = 'b',
+    AGENT_ERROR   = 'e'
+};
+
+// One decoded request; a batch arrives as its header (count) and the
+// server takes its actions one tick at a time
+struct AgentRequest {
+    AgentOp       op;
+    std::uint64_t seed;     // RESET
+    std::uint8_t  action;   // STEP
+    std::uint16_t count;    // BATCH
+};
+
+struct AgentState {
+    float         obs[SIM_OBS_SIZE];
+    float         reward;
+    std::int32_t  score;
+    std::uint32_t tick;
+    std::uint8_t  done;
+};
+
+static constexpr std::size_t AGENT_STATE_SIZE = SIM_OBS_SIZE * 4 + 4 + 4 + 4 + 1;
+static constexpr std::uint16_t AGENT_MAX_BATCH = 65535;
+
+enum class AgentParse { OK, INCOMPLETE, BAD_OPCODE };
+
+// Request header at p (a batch's actions are not consumed); advances p on OK
+AgentParse parseAgentRequest(const std::uint8_t*& p, const std::uint8_t* end, AgentRequest& out);
+
+// Encoders append to `out`
+void putAgentReset(std::vector<std::uint8_t>& out, std::uint64_t seed);
+void putAgentStep(std::vector<std::uint8_t>& out, bool flap);
+void putAgentBatch(std::vector<std::uint8_t>& out, const std::uint8_t* actions, std::uint16_t n);
+void putAgentObserve(std::vector<std::uint8_t>& out);
+void putAgentState(std::vector<std::uint8_t>& out, const AgentState& s);
+
+// STATE at p (AGENT_STATE_SIZE bytes available)
+AgentState readAgentState(const std::uint8_t* p);
@@ -0,0 +1,226 @@
+#include "AgentServer.h"
+#include "Log.h"
+#include <algorithm>
+
+// How long a closing connection gets to take its error reply
+static const sf::Time CLOSE_GRACE = sf::seconds(1.f);
+
+// ─── AgentSession ─────────────────────────────────────────────────────────
+AgentSession::AgentSession()
+    : readPos(0), batchLeft(0), done(false), steps(0), requests(0)
+{
+}
+
+void AgentSession::clear() {
+    in.clear();
+    out.clear();
+    readPos   = 0;
+    batchLeft = 0;
+    done      = false;
+    steps     = 0;
+    requests  = 0;
+}
+
+void AgentSession::feed(const std::uint8_t* data, std::size_t n) {
+    // Drop what has been consumed before growing the buffer
+    if (readPos > 0) {
+        in.erase(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(readPos));
+        readPos = 0;
+    }
+    in.insert(in.end(), data, data + n);
+}
+
+void AgentSession::putState(const SimWorld& world, float reward) {
+    AgentState s;
+    world.observe(s.obs);
+    s.reward = reward;
+    s.score  = world.getScore();
+    s.tick   = world.getTick();
+    s.done   = done ? 1 : 0;
+    putAgentState(out, s);
+}
+
+float AgentSession::tick(AgentHost& host, bool flap) {
+    if (done) return 0.f;
+    const int before = host.agentWorld().getScore();
+    host.agentStep(flap);
+    ++steps;
+    const SimWorld& world = host.agentWorld();
+    float reward = static_cast<float>(world.getScore() - before);
+    if (world.getBird().isDead() || world.isOver()) {
+        reward -= 1.f;
+        done = true;
+    }
+    return reward;
+}
+
+bool AgentSession::serve(AgentHost& host, int maxSteps) {
+    int budget = maxSteps;
+    const std::uint8_t* base = in.data();
+    const std::uint8_t* end  = base + in.size();
+    const std::uint8_t* p    = base + readPos;
+    bool ok = true;
+    while (p < end) {
+        if (batchLeft > 0) {
+            if (budget == 0) break;
+            const float r = tick(host, *p++ != 0);
+            putState(host.agentWorld(), r);
+            --batchLeft;
+            if (budget > 0) --budget;
+            continue;
+        }
+        const std::uint8_t* at = p;
+        AgentRequest req;
+        const AgentParse parsed = parseAgentRequest(p, end, req);
+        if (parsed == AgentParse::INCOMPLETE) break;
+        if (parsed == AgentParse::BAD_OPCODE) {
+            out.push_back(AGENT_ERROR);
+            out.push_back(*p);
+            ok = false;
+            break;
+        }
+        // A tick waits for the next serve() once the budget is spent
+        if ((req.op == AGENT_STEP || (req.op == AGENT_BATCH && req.count > 0)) && budget == 0) {
+            p = at;
+            break;
+        }
+        ++requests;
+        switch (req.op) {
+            case AGENT_RESET:
+                host.agentReset(req.seed);
+                done = false;
+                out.push_back(AGENT_RECORD);
+                putState(host.agentWorld(), 0.f);
+                break;
+            case AGENT_STEP: {
+                const float r = tick(host, req.action != 0);
+                if (budget > 0) --budget;
+                out.push_back(AGENT_RECORD);
+                putState(host.agentWorld(), r);
+                break;
+            }
+            case AGENT_BATCH:
+                out.push_back(AGENT_REPLY_BATCH);
+                out.push_back(static_cast<std::uint8_t>(req.count));
+                out.push_back(static_cast<std::uint8_t>(req.count >> 8));
+                batchLeft = req.count;
+                break;
+            default:   // AGENT_OBSERVE
+                out.push_back(AGENT_RECORD);
+                putState(host.agentWorld(), 0.f);
+                break;
+        }
+    }
+    readPos = static_cast<std::size_t>(p - base);
+    return ok;
+}
+
+// ─── AgentServer ──────────────────────────────────────────────────────────
+AgentServer::AgentServer() : listening(false), connected(false), closing(false), sessions(0) {}
+
+bool AgentServer::listen(unsigned short port) {
+    listening = listener.listen(port, sf::IpAddress::LocalHost) == sf::Socket::Done;
+    if (!listening) {
+        logLine("agent: cannot listen on 127.0.0.1:%u", static_cast<unsigned>(port));
+        return false;
+    }
+    listener.setBlocking(false);
+    selector.add(listener);
+    logLine("agent: listening on 127.0.0.1:%u", static_cast<unsigned>(port));
+    return true;
+}
+
+void AgentServer::wait(sf::Time timeout) {
+    if (!listening) return;
+    if (!unsent.empty()) timeout = std::min(timeout, sf::milliseconds(1));
+    selector.wait(timeout);
+}
+
+void AgentServer::disconnect(const char* why) {
+    const float secs = connectedFor.getElapsedTime().asSeconds();
+    logLine("agent: %s after %.2f s  |  %llu requests, %llu steps  |  %.0f steps/s", why, secs,
+                static_cast<unsigned long long>(session.getRequests()),
+                static_cast<unsigned long long>(session.getSteps()),
+                secs > 0.f ? static_cast<double>(session.getSteps()) / secs : 0.0);
+    selector.remove(client);
+    client.disconnect();
+    connected = false;
+    closing   = false;
+    ++sessions;
+    session.clear();
+    unsent.clear();
+}
+
+// Writes as much of the pending output as the socket takes
+bool AgentServer::flush() {
+    std::vector<std::uint8_t>& fresh = session.output();
+    unsent.insert(unsent.end(), fresh.begin(), fresh.end());
+    fresh.clear();
+    while (!unsent.empty()) {
+        std::size_t sent = 0;
+        const sf::Socket::Status st = client.send(unsent.data(), unsent.size(), sent);
+        unsent.erase(unsent.begin(), unsent.begin() + static_cast<std::ptrdiff_t>(sent));
+        if (st == sf::Socket::Done) continue;
+        if (st == sf::Socket::Partial || st == sf::Socket::NotReady) return true;
+        return false;
+    }
+    return true;
+}
+
+void AgentServer::poll(AgentHost& host, int maxSteps) {
+    if (!listening) return;
+    if (!connected) {
+        if (listener.accept(client) != sf::Socket::Done) return;
+        client.setBlocking(false);
+        selector.add(client);
+        connected = true;
+        session.clear();
+        connectedFor.restart();
+        logLine("agent: connected from %s", client.getRemoteAddress().toString().c_str());
+    }
+    if (closing) {
+        // Nothing more is read; the error reply goes out, then the socket closes
+        if (!flush() || unsent.empty() || closingFor.getElapsedTime() > CLOSE_GRACE)
+            disconnect("protocol error");
+        return;
+    }
+
+    std::uint8_t buf[16384];
+    for (;;) {
+        std::size_t got = 0;
+        const sf::Socket::Status st = client.receive(buf, sizeof(buf), got);
+        if (got > 0) session.feed(buf, got);
+        if (st == sf::Socket::Disconnected || st == sf::Socket::Error) {
+            disconnect("disconnected");
+            return;
+        }
+        if (st != sf::Socket::Done) break;
+    }
+
+    const bool ok = session.serve(host, maxSteps);
+    if (!flush()) { disconnect("send failed"); return; }
+    if (ok) return;
+    if (unsent.empty()) { disconnect("protocol error"); return; }
+    closing = true;
+    closingFor.restart();
+}
+
+// ─── WorldHost ────────────────────────────────────────────────────────────
+WorldHost::WorldHost(Difficulty d, HitboxMode mode, GapLayout layout, float dt)
+    : world(600.f, 800.f), dt(dt)
+{
+    world.setDifficulty(DifficultyParams::forLevel(d));
+    world.setHitboxMode(mode);
+    planner.setParams(FairGapParams::forLevel(d));
+    planner.setStep(dt);
+    if (layout == GapLayout::FAIR) world.setGapSource(&planner);
+    world.reset(0);
+}
+
+void WorldHost::agentReset(std::uint64_t seed) { world.reset(seed); }
+
+void WorldHost::agentStep(bool flap) {
+    if (world.getGapSource() == &planner) planner.advance(GapPlanner::WORK_PER_TICK);
+    if (flap) world.flap();
+    world.step(dt);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <SFML/Network.hpp>
+#include <cstdint>
+#include <vector>
+#include "AgentProtocol.h"
+#include "FairGaps.h"
+
+// ─── Agent server ─────────────────────────────────────────────────────────
+// Lets an agent in another process play through AgentProtocol.h over a
+// local TCP connection (127.0.0.1, one client at a time). The server only
+// speaks the protocol; whatever owns the world does the stepping through
+// AgentHost, so the windowed Game and a bare headless world serve the
+// same way.
+
+class AgentHost {
+public:
+    virtual ~AgentHost() = default;
+    virtual void agentReset(std::uint64_t seed) = 0;
+    virtual void agentStep(bool flap) = 0;   // one tick
+    virtual const SimWorld& agentWorld() const = 0;
+};
+
+// Protocol state of one connection, without sockets: bytes in, bytes out
+class AgentSession {
+public:
+    AgentSession();
+
+    void clear();
+    void feed(const std::uint8_t* data, std::size_t n);
+    // Answers buffered requests, stepping at most maxSteps ticks (< 0: no
+    // limit). False after a protocol error; the error reply is queued.
+    bool serve(AgentHost& host, int maxSteps);
+    std::vector<std::uint8_t>& output() { return out; }
+
+    std::uint64_t getSteps() const { return steps; }
+    std::uint64_t getRequests() const { return requests; }
+
+private:
+    std::vector<std::uint8_t> in;
+    std::size_t   readPos;
+    std::vector<std::uint8_t> out;
+    std::uint16_t batchLeft;   // actions still to come for the open batch
+    bool          done;
+    std::uint64_t steps;
+    std::uint64_t requests;
+
+    void putState(const SimWorld& world, float reward);
+    float tick(AgentHost& host, bool flap);
+};
+
+class AgentServer {
+public:
+    AgentServer();
+
+    bool listen(unsigned short port);
+    bool isListening() const { return listening; }
+    bool hasClient() const { return connected; }
+    bool hasPendingOutput() const { return !unsent.empty(); }
+    int  getSessions() const { return sessions; }   // connections closed so far
+
+    // Accepts, reads, serves and writes whatever is ready; never blocks
+    void poll(AgentHost& host, int maxSteps);
+    // Sleeps until the listener or the client has something, or timeout.
+    // The selector only sees incoming data, so while replies are still
+    // queued it returns within a millisecond to retry the send.
+    void wait(sf::Time timeout);
+
+private:
+    sf::TcpListener    listener;
+    sf::TcpSocket      client;
+    sf::SocketSelector selector;
+    bool listening;
+    bool connected;
+    bool closing;     // after a protocol error: sending the error reply, then closing
+    int  sessions;
+    AgentSession session;
+    std::vector<std::uint8_t> unsent;
+    sf::Clock connectedFor;
+    sf::Clock closingFor;
+
+    void disconnect(const char* why);
+    bool flush();
+};
+
+// A bare world with the game's rules, for serving without a window
+class WorldHost : public AgentHost {
+public:
+    WorldHost(Difficulty d, HitboxMode mode, GapLayout layout, float dt);
+
+    void agentReset(std::uint64_t seed) override;
+    void agentStep(bool flap) override;
+    const SimWorld& agentWorld() const override { return world; }
+
+private:
+    SimWorld   world;
+    GapPlanner planner;
+    float      dt;
+};
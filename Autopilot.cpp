@@ -0,0 +1,152 @@
+#include "Autopilot.h"
+#include "Collision.h"
+#include <algorithm>
+#include <cmath>
+
+// ─── LatencyStats ─────────────────────────────────────────────────────────
+void LatencyStats::add(float micros) {
+    if (samples.size() < static_cast<std::size_t>(WINDOW)) samples.push_back(micros);
+    else samples[static_cast<std::size_t>(count % WINDOW)] = micros;
+    ++count;
+    maxMicros = std::max(maxMicros, micros);
+}
+
+void LatencyStats::clear() {
+    samples.clear();
+    count     = 0;
+    maxMicros = 0.f;
+}
+
+float LatencyStats::percentile(float q) const {
+    if (samples.empty()) return 0.f;
+    std::vector<float> sorted(samples);
+    std::size_t k = static_cast<std::size_t>(q * static_cast<float>(sorted.size() - 1) + 0.5f);
+    k = std::min(k, sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(k), sorted.end());
+    return sorted[k];
+}
+
+// ─── Autopilot ────────────────────────────────────────────────────────────
+Autopilot::Autopilot(const AutopilotParams& params)
+    : params(params), scratch(600.f, 800.f), table(TABLE_SIZE, Entry{ -1, -1, 0, 0, 0, 0, 0, -1 }),
+      dt(1.f / 120.f), spacing(1), cap(0), lastTick(0), epoch(0), nodes(0), outOfTime(false), lastReach(0)
+{
+}
+
+bool Autopilot::decide(const SimWorld& world, float stepDt) {
+    const Clock::time_point t0 = Clock::now();
+    deadline  = t0 + std::chrono::nanoseconds(static_cast<long long>(params.budgetMicros * 1000.f));
+    nodes     = 0;
+    outOfTime = false;
+
+    const int now      = static_cast<int>(world.getTick());
+    const int horizon  = std::max(1, static_cast<int>(std::lround(params.horizon / stepDt)));
+    int       gap      = std::max(1, static_cast<int>(std::lround(params.decisionGap / stepDt)));
+    gap = std::max(gap, (horizon + MAX_LEVELS - 1) / MAX_LEVELS);
+    // A new run, or a new grid: nothing in the table applies
+    if (now < lastTick || gap != spacing || stepDt != dt) ++epoch;
+    lastTick = now;
+    spacing  = gap;
+    dt       = stepDt;
+    cap      = now + horizon;
+
+    bool flap = false;
+    lastReach = 0;
+    if (!world.getBird().isDead()) {
+        // The promising choice first: if it survives the horizon the other
+        // is never searched. Later choices sit on the grid, so the line
+        // chosen last tick is still in this tree (as "no flap now").
+        world.save(stack[0]);
+        const int toGrid = spacing - now % spacing;
+        const bool first = prefersFlap(world);
+        int reach = search(0, first, toGrid);
+        flap      = first;
+        if (reach < cap && !outOfTime) {
+            int other = search(0, !first, toGrid);
+            if (other > reach) { reach = other; flap = !first; }
+        }
+        lastReach = reach - now;
+    }
+
+    latency.add(std::chrono::duration<float, std::micro>(Clock::now() - t0).count());
+    return flap;
+}
+
+bool Autopilot::spent() {
+    if (params.maxNodes > 0) outOfTime = nodes >= params.maxNodes;
+    else                     outOfTime = Clock::now() >= deadline;
+    return outOfTime;
+}
+
+// Table slot for a grid state. Height and velocity are rounded to MERGE
+// and tilt to a degree, so nearly equal states share what was learnt: not
+// exact, but it lets the search reuse far more than it gets wrong.
+Autopilot::Entry* Autopilot::lookup(std::uint32_t tick, const SimBird& b) {
+    const std::int32_t t    = static_cast<std::int32_t>(tick);
+    const std::int32_t y    = static_cast<std::int32_t>(std::lround(b.y * (1.f / MERGE)));
+    const std::int32_t v    = static_cast<std::int32_t>(std::lround(b.velocity * (1.f / MERGE)));
+    const std::int32_t tilt = static_cast<std::int32_t>(std::lround(b.rotation));
+    std::uint32_t h = static_cast<std::uint32_t>(t) * 0x9E3779B1u;
+    h = (h ^ static_cast<std::uint32_t>(y))    * 0x85EBCA77u;
+    h = (h ^ static_cast<std::uint32_t>(v))    * 0xC2B2AE3Du;
+    h = (h ^ static_cast<std::uint32_t>(tilt)) * 0x27D4EB2Fu;
+    Entry& e = table[(h ^ (h >> 15)) & (TABLE_SIZE - 1)];
+    if (e.epoch != epoch || e.tick != t || e.y != y || e.v != v || e.tilt != tilt)
+        e = Entry{ epoch, t, y, v, tilt, -1, 0, -1 };
+    return &e;
+}
+
+// Absolute tick the best line found from stack[level] survives to, capped
+// at `cap`. `flap` is the choice at this point and `ticks` how long the
+// bird coasts after it, up to the next grid point.
+int Autopilot::search(int level, bool flap, int ticks) {
+    ++nodes;
+    scratch.restore(stack[level]);
+    if (flap) scratch.flap();
+    for (int i = 0; i < ticks; ++i) {
+        if (static_cast<int>(scratch.getTick()) >= cap) return cap;
+        scratch.step(dt);
+        if (scratch.getBird().isDead()) return static_cast<int>(scratch.getTick()) - 1;
+    }
+    const int here = static_cast<int>(scratch.getTick());
+    if (here >= cap) return cap;
+
+    // Known: exact if it died before its cap, a survivor if its cap was ours
+    Entry* e = lookup(scratch.getTick(), scratch.getBird());
+    if (e->reach >= 0 && (e->reach < e->cap || e->cap >= cap)) return std::min(e->reach, cap);
+    if (spent()) return here;
+
+    scratch.save(stack[level + 1]);
+    const bool first = e->flap >= 0 ? e->flap != 0 : prefersFlap(scratch);
+    int  best     = search(level + 1, first, spacing);
+    bool bestFlap = first;
+    if (best < cap && !outOfTime) {
+        int other = search(level + 1, !first, spacing);
+        if (other > best) { best = other; bestFlap = !first; }
+    }
+    // Only a finished search is worth keeping; the slot may have been
+    // taken by a deeper state meanwhile
+    if (!outOfTime) {
+        e = lookup(stack[level + 1].tick, stack[level + 1].bird);
+        e->reach = best;
+        e->cap   = cap;
+        e->flap  = bestFlap ? 1 : 0;
+    }
+    return best;
+}
+
+// Flap first when the bird is below the line through the lower part of the
+// next gap (or mid-air with no pipe ahead)
+bool Autopilot::prefersFlap(const SimWorld& world) const {
+    const SimBird&  bird  = world.getBird();
+    const PipeRing& pipes = world.getPipes();
+    const float     left  = bird.getBounds().left;
+    float target = world.getGroundY() * 0.5f;
+    for (int i = 0; i < pipes.size(); ++i) {
+        const SimPipe& p = pipes[i];
+        if (pipeRight(p.x) <= left) continue;
+        target = p.botY - (p.botY - p.topY) * 0.35f;
+        break;
+    }
+    return bird.y > target;
+}
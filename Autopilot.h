@@ -0,0 +1,102 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "SimWorld.h"
+
+// ─── Autopilot ────────────────────────────────────────────────────────────
+// Plays a SimWorld by search, not by rules of thumb: before each tick it
+// branches the world with snapshots and steps the real physics forward
+// through flap / no-flap choices made every `decisionGap` seconds, looking
+// for a line that survives `horizon` seconds. The choice that reaches
+// furthest wins; the search is depth-first with the more promising choice
+// first, so an easy stretch costs one line and a hard one gets the whole
+// budget.
+//
+// Choices after the first sit on a grid of absolute ticks, so the states
+// the search meets recur from one decision to the next. A lossy table
+// remembers how far each one (tick, height, velocity, tilt) got and which
+// way it went, so a deep horizon is searched a little more every tick.
+//
+// The budget is wall-clock per decision. A node budget replaces it when
+// set, which makes the bot deterministic for regression baselines.
+
+struct AutopilotParams {
+    float budgetMicros = 200.f;        // search time per decision
+    int   maxNodes     = 0;            // decision points per decision instead, 0 for off
+    float decisionGap  = 1.f / 15.f;   // s between choices along a line
+    float horizon      = 2.f;          // s a line must survive to settle the search
+};
+
+// Decision latencies in microseconds. Keeps the newest WINDOW samples for
+// the percentiles plus all-time count and maximum.
+class LatencyStats {
+public:
+    static constexpr int WINDOW = 8192;
+
+    void  add(float micros);
+    void  clear();
+    // q in [0, 1] over the kept window; sorts a copy, so call it for reports
+    float percentile(float q) const;
+    float getMax() const { return maxMicros; }
+    std::uint64_t getCount() const { return count; }
+
+private:
+    std::vector<float> samples;
+    std::uint64_t count = 0;
+    float maxMicros = 0.f;
+};
+
+class Autopilot {
+public:
+    explicit Autopilot(const AutopilotParams& params = AutopilotParams());
+
+    void setParams(const AutopilotParams& p) { params = p; }
+    const AutopilotParams& getParams() const { return params; }
+
+    // True if the bird should flap before the world's next step of dt.
+    // The world is only read; the search runs on a private copy.
+    bool decide(const SimWorld& world, float dt);
+
+    const LatencyStats& getLatency() const { return latency; }
+    void resetLatency() { latency.clear(); }
+    int  getLastReach() const { return lastReach; }   // ticks the chosen line survived, up to the horizon
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Deepest line: `horizon` / `decisionGap` plus slack for odd tick rates
+    static constexpr int MAX_LEVELS = 64;
+    static constexpr int   TABLE_SIZE = 1 << 16;   // power of two
+    static constexpr float MERGE      = 4.f;       // px and px/s within which states share an entry
+
+    // How far the best line from a grid state got (exact if below `cap`,
+    // at least `cap` otherwise) and its first choice, which is tried first
+    // when the state comes back under a later cap
+    struct Entry {
+        std::int32_t epoch, tick, y, v, tilt;
+        std::int32_t reach, cap;
+        std::int32_t flap;   // -1 before the first search
+    };
+
+    AutopilotParams params;
+    SimWorld    scratch;
+    SimSnapshot stack[MAX_LEVELS + 1];   // world at each decision point of the line
+    std::vector<Entry> table;
+    LatencyStats latency;
+
+    Clock::time_point deadline;
+    float dt;
+    int   spacing;        // ticks between decision points
+    int   cap;            // absolute tick a line must reach
+    int   lastTick;
+    int   epoch;          // bumped when the world goes back: older entries are void
+    int   nodes;
+    bool  outOfTime;
+    int   lastReach;
+
+    int  search(int level, bool flap, int ticks);
+    Entry* lookup(std::uint32_t tick, const SimBird& bird);
+    bool prefersFlap(const SimWorld& world) const;
+    bool spent();
+};
@@ -0,0 +1,394 @@
+#include "BatchEnv.h"
+#include "Collision.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Constants shared with SimWorld / SimBird; the scalar path uses Collision.h
+// directly and the AVX2 path keeps its operation order so both round alike.
+static const float BIRD_X  = SimWorld::BIRD_START_X;
+static const float GRAVITY = 1500.f;
+static const float FLAP    = -520.f;
+static const float EMPTY_X = INFINITY;   // empty slot: never scores or hits
+
+BatchEnv::BatchEnv(int count, Difficulty difficulty, std::uint64_t seed, float dt)
+    : count(count), lanes((count + 7) & ~7), dt(dt),
+      width(600.f), groundY(800.f - SimWorld::GROUND_H),
+      base(DifficultyParams::forLevel(difficulty)), rules(600.f, 800.f),
+      parkedCount(0), useSimd(true), hitbox(HitboxMode::BOX), totalSteps(0), episodes(0), elapsed(0.0)
+{
+    const size_t n = static_cast<size_t>(lanes);
+    y.resize(n); vel.resize(n);
+    speed.resize(n); gap.resize(n); interval.resize(n); spawnTimer.resize(n);
+    score.resize(n);
+    x0.resize(n); top0.resize(n); bot0.resize(n); passed0.resize(n);
+    x1.resize(n); top1.resize(n); bot1.resize(n); passed1.resize(n);
+    reward.resize(n); done.resize(n); lastScore.resize(n);
+    pose.assign(n, SimBird(BIRD_X, SimWorld::BIRD_START_Y));
+    gapSource.assign(n, nullptr);
+    spawned.assign(n, 0);
+    parked.assign(n, 0);
+    rules.setDifficulty(base);
+
+    // Lane i draws the same course as SimWorld(…, seed + i)
+    rng.reserve(n);
+    for (int i = 0; i < lanes; ++i) rng.emplace_back(seed + static_cast<std::uint64_t>(i), RNG_STREAM_GAMEPLAY);
+    resetAll();
+}
+
+bool BatchEnv::simdAvailable() const {
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void BatchEnv::setHitboxMode(HitboxMode mode) {
+    hitbox = mode;
+    resetAll();
+}
+
+void BatchEnv::setGapSource(int i, GapSource* source) {
+    if (i < 0 || i >= count) return;
+    gapSource[static_cast<size_t>(i)] = source;
+    resetLane(i);
+}
+
+double BatchEnv::getStepsPerSecond() const {
+    return elapsed > 0.0 ? static_cast<double>(totalSteps) / elapsed : 0.0;
+}
+
+void BatchEnv::resetAll() {
+    std::fill(parked.begin(), parked.end(), 0);
+    parkedCount = 0;
+    for (int i = 0; i < lanes; ++i) {
+        resetLane(i);
+        reward[i] = 0.f; done[i] = 0; lastScore[i] = 0;
+    }
+}
+
+void BatchEnv::resetLane(int i) {
+    y[i]          = SimWorld::BIRD_START_Y;
+    vel[i]        = 0.f;
+    speed[i]      = base.pipeSpeed;
+    gap[i]        = base.pipeGap;
+    interval[i]   = base.spawnInterval;
+    spawnTimer[i] = 0.f;
+    score[i]      = 0;
+    pose[i].reset(BIRD_X, SimWorld::BIRD_START_Y);
+    x0[i] = EMPTY_X; top0[i] = 0.f; bot0[i] = 0.f; passed0[i] = 1.f;
+    x1[i] = EMPTY_X; top1[i] = 0.f; bot1[i] = 0.f; passed1[i] = 1.f;
+    spawned[i] = 0;
+    // Same draws as SimWorld::reset, so a lane's fair course follows its seed
+    if (gapSource[i]) {
+        std::uint64_t hi = rng[i].nextU32();
+        gapSource[i]->restart(rules, (hi << 32) | rng[i].nextU32());
+    }
+}
+
+// Same draw and arithmetic as SimWorld::spawnPipe
+void BatchEnv::spawnLane(int i) {
+    spawnTimer[i] = 0.f;
+    float minY = 140.f;
+    float maxY = groundY - gap[i] * 0.5f;
+    float gapY = gapSource[i] ? gapSource[i]->gapCentre(spawned[i]) : rng[i].uniform(minY, maxY);
+    ++spawned[i];
+    float half = gap[i] / 2.f;
+
+    if (x0[i] != EMPTY_X && x1[i] != EMPTY_X) retireLane(i);   // cannot happen at 600 px
+    if (x0[i] == EMPTY_X) {
+        x0[i] = width + 20.f; top0[i] = gapY - half; bot0[i] = gapY + half; passed0[i] = 0.f;
+    } else {
+        x1[i] = width + 20.f; top1[i] = gapY - half; bot1[i] = gapY + half; passed1[i] = 0.f;
+    }
+}
+
+void BatchEnv::scoreLane(int i) {
+    score[i]++;
+    reward[i] += 1.f;
+    if (score[i] % 10 == 0) {
+        DifficultyParams d{ speed[i], gap[i], interval[i] };
+        d.ramp();
+        speed[i] = d.pipeSpeed; gap[i] = d.pipeGap; interval[i] = d.spawnInterval;
+    }
+    if (hitbox == HitboxMode::HULL && score[i] % 5 == 0) pose[i].celebrate();
+}
+
+// Slot 0 has scrolled past the bird: promote slot 1
+void BatchEnv::retireLane(int i) {
+    x0[i] = x1[i]; top0[i] = top1[i]; bot0[i] = bot1[i]; passed0[i] = passed1[i];
+    x1[i] = EMPTY_X; top1[i] = 0.f; bot1[i] = 0.f; passed1[i] = 1.f;
+}
+
+void BatchEnv::killLane(int i) {
+    reward[i]   -= 1.f;
+    done[i]      = 1;
+    lastScore[i] = score[i];
+    if (i < count) ++episodes;   // padding lanes run along but are nobody's episodes
+    resetLane(i);
+}
+
+void BatchEnv::truncate(int i) {
+    done[i]      = 1;
+    lastScore[i] = score[i];
+    if (i < count) ++episodes;
+    resetLane(i);
+}
+
+void BatchEnv::park(int i) {
+    if (i < 0 || i >= count || parked[i]) return;
+    parked[i] = 1;
+    ++parkedCount;
+}
+
+bool BatchEnv::hitsLane(int i, float px, float top, float bot, float dx, float dy) const {
+    PipeRects r = pipeRects(px, top, bot, groundY);
+    if (hitbox == HitboxMode::HULL) {
+        if (px == EMPTY_X) return false;
+        return hullHitsPipe(BIRD_X, y[i], pose[i].rotation, dx, dy, r);
+    }
+    SimRect bb{ BIRD_X - 22.f, y[i] - 18.f, 44.f, 36.f };
+    return boxHitsPipe(bb, r) || sweptHitsPipe(bb, 1.f / dx, 1.f / dy, r);
+}
+
+void BatchEnv::step(const std::uint8_t* actions) {
+    auto t0 = std::chrono::steady_clock::now();
+    std::memset(reward.data(), 0, reward.size() * sizeof(float));
+    std::memset(done.data(), 0, done.size());
+
+#if defined(__AVX2__)
+    if (useSimd && hitbox == HitboxMode::BOX) stepAvx2(actions);
+    else         stepScalar(actions);
+#else
+    stepScalar(actions);
+#endif
+
+    totalSteps += static_cast<std::uint64_t>(count - parkedCount);
+    elapsed    += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// ─── Scalar kernel ────────────────────────────────────────────────────────
+// Same order as SimWorld::step: bird, spawn, pipes (score + ramp), collision.
+void BatchEnv::stepScalar(const std::uint8_t* actions) {
+    const float W  = SimWorld::PIPE_WIDTH;
+    const float o  = SimWorld::PIPE_OUTLINE;
+    const float ov = SimWorld::PIPE_CAP_OVERHANG;
+    // A passed pipe can be dropped once it is left of everything that can hit
+    const float birdLeft = hitbox == HitboxMode::HULL
+                         ? BIRD_X - BirdHull::instance().getReach() - 1.f : BIRD_X - 22.f;
+
+    for (int i = 0; i < lanes; ++i) {
+        if (parked[i]) continue;
+        const float prevY = y[i];
+        const bool  act   = i < count && actions[i];
+        if (hitbox == HitboxMode::HULL) {
+            if (act) pose[i].flap();
+            pose[i].update<float>(dt);
+            y[i]   = pose[i].y;
+            vel[i] = pose[i].velocity;
+        } else {
+            if (act) vel[i] = FLAP;
+            vel[i] += GRAVITY * dt;
+            y[i]   += vel[i] * dt;
+        }
+
+        spawnTimer[i] += dt;
+        if (spawnTimer[i] >= interval[i]) spawnLane(i);
+
+        x0[i] -= speed[i] * dt;
+        if (passed0[i] == 0.f && x0[i] + W < BIRD_X) { passed0[i] = 1.f; scoreLane(i); }
+        x1[i] -= speed[i] * dt;
+        if (passed1[i] == 0.f && x1[i] + W < BIRD_X) { passed1[i] = 1.f; scoreLane(i); }
+
+        const float dx = speed[i] * dt;
+        const float dy = y[i] - prevY;
+        bool dead = hitsLane(i, x0[i], top0[i], bot0[i], dx, dy) ||
+                    hitsLane(i, x1[i], top1[i], bot1[i], dx, dy) ||
+                    y[i] < 0.f || y[i] >= groundY;
+        if (dead) { killLane(i); continue; }
+
+        float capRight = ((x0[i] - ov) - o) + ((W + 2.f * ov) + 2.f * o);
+        if (passed0[i] != 0.f && !(birdLeft < capRight)) retireLane(i);
+    }
+}
+
+// ─── AVX2 kernel ──────────────────────────────────────────────────────────
+#if defined(__AVX2__)
+void BatchEnv::stepAvx2(const std::uint8_t* actions) {
+    const float W     = SimWorld::PIPE_WIDTH;
+    const float o     = SimWorld::PIPE_OUTLINE;
+    const float CH    = SimWorld::PIPE_CAP_H;
+    const float ov    = SimWorld::PIPE_CAP_OVERHANG;
+
+    const __m256 vdt     = _mm256_set1_ps(dt);
+    const __m256 vgdt    = _mm256_set1_ps(GRAVITY * dt);
+    const __m256 vflap   = _mm256_set1_ps(FLAP);
+    const __m256 vW      = _mm256_set1_ps(W);
+    const __m256 vBX     = _mm256_set1_ps(BIRD_X);
+    const __m256 vLeft   = _mm256_set1_ps(BIRD_X - 22.f);
+    const __m256 vRight  = _mm256_set1_ps((BIRD_X - 22.f) + 44.f);
+    const __m256 vo      = _mm256_set1_ps(o);
+    const __m256 vneg_o  = _mm256_set1_ps(-o);
+    const __m256 v2o     = _mm256_set1_ps(2.f * o);
+    const __m256 vov     = _mm256_set1_ps(ov);
+    const __m256 vBodyW  = _mm256_set1_ps(W + 2.f * o);
+    const __m256 vCapW   = _mm256_set1_ps((W + 2.f * ov) + 2.f * o);
+    const __m256 vCH     = _mm256_set1_ps(CH);
+    const __m256 vCapH   = _mm256_set1_ps(CH + 2.f * o);
+    const __m256 v18     = _mm256_set1_ps(18.f);
+    const __m256 v36     = _mm256_set1_ps(36.f);
+    const __m256 v44     = _mm256_set1_ps(44.f);
+    const __m256 vOne    = _mm256_set1_ps(1.f);
+    const __m256 vTBLo   = _mm256_set1_ps(-o - 36.f);
+    const __m256 vGround = _mm256_set1_ps(groundY);
+    const __m256 vZero   = _mm256_setzero_ps();
+
+    // Collision.h sweepSlab / sweptIntersects; min/max_ps pick the second
+    // operand on NaN, matching the scalar ternaries.
+    auto slab = [](__m256 p, __m256 lo, __m256 hi, __m256 inv, __m256& uMin, __m256& uMax) {
+        __m256 a = _mm256_mul_ps(_mm256_sub_ps(p, hi), inv);
+        __m256 b = _mm256_mul_ps(_mm256_sub_ps(p, lo), inv);
+        uMin = _mm256_min_ps(a, b);
+        uMax = _mm256_max_ps(a, b);
+    };
+    auto swept = [&](__m256 x0, __m256 x1, __m256 bTop, __m256 lo, __m256 hi, __m256 invDy) {
+        __m256 y0, y1;
+        slab(bTop, lo, hi, invDy, y0, y1);
+        __m256 uLo = _mm256_max_ps(x0, y0);
+        __m256 uHi = _mm256_min_ps(x1, y1);
+        return _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(uLo, uHi, _CMP_LT_OQ),
+                                           _mm256_cmp_ps(uLo, vOne, _CMP_LT_OQ)),
+                             _mm256_cmp_ps(uHi, vZero, _CMP_GT_OQ));
+    };
+
+    // One pipe slot against the bird box: the four outlined rects of
+    // Collision.h, overlapping at the end of the step or swept along it,
+    // evaluated for 8 lanes at once.
+    auto hits = [&](__m256 px, __m256 top, __m256 bot, __m256 bTop, __m256 bBot,
+                    __m256 invDx, __m256 invDy) {
+        __m256 bodyL = _mm256_sub_ps(px, vo);
+        __m256 bodyR = _mm256_add_ps(bodyL, vBodyW);
+        __m256 capL  = _mm256_sub_ps(_mm256_sub_ps(px, vov), vo);
+        __m256 capR  = _mm256_add_ps(capL, vCapW);
+        __m256 inBody = _mm256_and_ps(_mm256_cmp_ps(vLeft, bodyR, _CMP_LT_OQ),
+                                      _mm256_cmp_ps(bodyL, vRight, _CMP_LT_OQ));
+        __m256 inCap  = _mm256_and_ps(_mm256_cmp_ps(vLeft, capR, _CMP_LT_OQ),
+                                      _mm256_cmp_ps(capL, vRight, _CMP_LT_OQ));
+
+        __m256 tbBot  = _mm256_add_ps(vneg_o, _mm256_add_ps(top, v2o));
+        __m256 hitTB  = _mm256_and_ps(_mm256_cmp_ps(bTop, tbBot, _CMP_LT_OQ),
+                                      _mm256_cmp_ps(vneg_o, bBot, _CMP_LT_OQ));
+        __m256 tcTop  = _mm256_sub_ps(_mm256_sub_ps(top, vCH), vo);
+        __m256 hitTC  = _mm256_and_ps(_mm256_cmp_ps(bTop, _mm256_add_ps(tcTop, vCapH), _CMP_LT_OQ),
+                                      _mm256_cmp_ps(tcTop, bBot, _CMP_LT_OQ));
+        __m256 bTopY  = _mm256_sub_ps(bot, vo);
+        __m256 bbH    = _mm256_add_ps(_mm256_sub_ps(vGround, bot), v2o);
+        __m256 hitBB  = _mm256_and_ps(_mm256_cmp_ps(bTop, _mm256_add_ps(bTopY, bbH), _CMP_LT_OQ),
+                                      _mm256_cmp_ps(bTopY, bBot, _CMP_LT_OQ));
+        __m256 hitBC  = _mm256_and_ps(_mm256_cmp_ps(bTop, _mm256_add_ps(bTopY, vCapH), _CMP_LT_OQ),
+                                      _mm256_cmp_ps(bTopY, bBot, _CMP_LT_OQ));
+
+        __m256 body = _mm256_and_ps(inBody, _mm256_or_ps(hitTB, hitBB));
+        __m256 cap  = _mm256_and_ps(inCap,  _mm256_or_ps(hitTC, hitBC));
+        __m256 hit  = _mm256_or_ps(body, cap);
+
+        __m256 bx0, bx1, cx0, cx1;
+        slab(vLeft, _mm256_sub_ps(bodyL, v44), bodyR, invDx, bx0, bx1);
+        slab(vLeft, _mm256_sub_ps(capL, v44),  capR,  invDx, cx0, cx1);
+        hit = _mm256_or_ps(hit, swept(bx0, bx1, bTop, vTBLo, tbBot, invDy));
+        hit = _mm256_or_ps(hit, swept(bx0, bx1, bTop, _mm256_sub_ps(bTopY, v36),
+                                      _mm256_add_ps(bTopY, bbH), invDy));
+        hit = _mm256_or_ps(hit, swept(cx0, cx1, bTop, _mm256_sub_ps(tcTop, v36),
+                                      _mm256_add_ps(tcTop, vCapH), invDy));
+        hit = _mm256_or_ps(hit, swept(cx0, cx1, bTop, _mm256_sub_ps(bTopY, v36),
+                                      _mm256_add_ps(bTopY, vCapH), invDy));
+        return hit;
+    };
+
+    for (int i = 0; i < lanes; i += 8) {
+        // A group of eight parked lanes is skipped outright. In a mixed group
+        // the parked lanes' birds and pipes drift along unused (resetAll puts
+        // them back), but every event is masked off for them.
+        __m256i p8 = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&parked[i])));
+        __m256i pM = _mm256_cmpgt_epi32(p8, _mm256_setzero_si256());
+        const int live = ~_mm256_movemask_ps(_mm256_castsi256_ps(pM)) & 0xFF;
+        if (!live) continue;
+
+        // Flap: actions beyond count are padding and never flap
+        std::uint8_t act[8] = {};
+        std::memcpy(act, actions + i, static_cast<size_t>(std::min(8, std::max(0, count - i))));
+        __m256i a8   = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(act)));
+        __m256 flapM = _mm256_castsi256_ps(_mm256_cmpgt_epi32(a8, _mm256_setzero_si256()));
+
+        __m256 v   = _mm256_loadu_ps(&vel[i]);
+        __m256 py0 = _mm256_loadu_ps(&y[i]);
+        __m256 py  = py0;
+        v  = _mm256_blendv_ps(v, vflap, flapM);
+        v  = _mm256_add_ps(v, vgdt);
+        py = _mm256_add_ps(py, _mm256_mul_ps(v, vdt));
+        _mm256_storeu_ps(&vel[i], v);
+        _mm256_storeu_ps(&y[i], py);
+
+        // Spawn
+        __m256 t = _mm256_add_ps(_mm256_loadu_ps(&spawnTimer[i]), vdt);
+        _mm256_storeu_ps(&spawnTimer[i], t);
+        int m = _mm256_movemask_ps(_mm256_cmp_ps(t, _mm256_loadu_ps(&interval[i]), _CMP_GE_OQ)) & live;
+        while (m) { int k = __builtin_ctz(m); m &= m - 1; spawnLane(i + k); }
+
+        // Slot 0 moves, scores (a ramp changes speed for slot 1), then slot 1
+        __m256 px0 = _mm256_sub_ps(_mm256_loadu_ps(&x0[i]),
+                                   _mm256_mul_ps(_mm256_loadu_ps(&speed[i]), vdt));
+        _mm256_storeu_ps(&x0[i], px0);
+        m = _mm256_movemask_ps(_mm256_and_ps(
+                _mm256_cmp_ps(_mm256_loadu_ps(&passed0[i]), vZero, _CMP_EQ_OQ),
+                _mm256_cmp_ps(_mm256_add_ps(px0, vW), vBX, _CMP_LT_OQ))) & live;
+        while (m) { int k = __builtin_ctz(m); m &= m - 1; passed0[i + k] = 1.f; scoreLane(i + k); }
+
+        __m256 px1 = _mm256_sub_ps(_mm256_loadu_ps(&x1[i]),
+                                   _mm256_mul_ps(_mm256_loadu_ps(&speed[i]), vdt));
+        _mm256_storeu_ps(&x1[i], px1);
+        m = _mm256_movemask_ps(_mm256_and_ps(
+                _mm256_cmp_ps(_mm256_loadu_ps(&passed1[i]), vZero, _CMP_EQ_OQ),
+                _mm256_cmp_ps(_mm256_add_ps(px1, vW), vBX, _CMP_LT_OQ))) & live;
+        while (m) { int k = __builtin_ctz(m); m &= m - 1; passed1[i + k] = 1.f; scoreLane(i + k); }
+
+        // Collision, ceiling, ground
+        // (speed is reloaded: a score above may have ramped it)
+        __m256 bTop  = _mm256_sub_ps(py, v18);
+        __m256 bBot  = _mm256_add_ps(bTop, v36);
+        __m256 invDx = _mm256_div_ps(vOne, _mm256_mul_ps(_mm256_loadu_ps(&speed[i]), vdt));
+        __m256 invDy = _mm256_div_ps(vOne, _mm256_sub_ps(py, py0));
+        __m256 dead = _mm256_or_ps(
+            hits(px0, _mm256_loadu_ps(&top0[i]), _mm256_loadu_ps(&bot0[i]), bTop, bBot, invDx, invDy),
+            hits(px1, _mm256_loadu_ps(&top1[i]), _mm256_loadu_ps(&bot1[i]), bTop, bBot, invDx, invDy));
+        dead = _mm256_or_ps(dead, _mm256_cmp_ps(py, vZero, _CMP_LT_OQ));
+        dead = _mm256_or_ps(dead, _mm256_cmp_ps(py, vGround, _CMP_GE_OQ));
+        int deadM = _mm256_movemask_ps(dead) & live;
+        m = deadM;
+        while (m) { int k = __builtin_ctz(m); m &= m - 1; killLane(i + k); }
+
+        // Retire slot 0 once it is passed and entirely left of the bird
+        __m256 capRight = _mm256_add_ps(_mm256_sub_ps(_mm256_sub_ps(px0, vov), vo), vCapW);
+        m = _mm256_movemask_ps(_mm256_and_ps(
+                _mm256_cmp_ps(_mm256_loadu_ps(&passed0[i]), vZero, _CMP_NEQ_OQ),
+                _mm256_cmp_ps(capRight, vLeft, _CMP_LE_OQ))) & live & ~deadM;
+        while (m) { int k = __builtin_ctz(m); m &= m - 1; retireLane(i + k); }
+    }
+}
+#endif
+
+void BatchEnv::observe(float* out) const {
+    for (int i = 0; i < count; ++i) {
+        float* o = out + static_cast<size_t>(i) * OBS_SIZE;
+        o[OBS_Y]        = y[i];
+        o[OBS_VELOCITY] = vel[i];
+        o[OBS_PIPE_X]   = x0[i] == EMPTY_X ? width + 20.f : x0[i];
+        o[OBS_PIPE_TOP] = x0[i] == EMPTY_X ? 0.f : top0[i];
+        o[OBS_PIPE_BOT] = x0[i] == EMPTY_X ? groundY : bot0[i];
+    }
+}
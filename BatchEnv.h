@@ -0,0 +1,115 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "SimWorld.h"
+
+// ─── Batched environment ──────────────────────────────────────────────────
+// Steps N independent worlds per call, stored structure-of-arrays. Each lane
+// reproduces SimWorld exactly for the same seed and flap sequence (bird
+// y/velocity, pipe spawning, scoring, the ramp and the swept box collision), but
+// an episode ends at the tick the bird dies rather than when it lands.
+//
+// Built with -mavx2 the kernel advances 8 lanes per instruction; rare events
+// (spawns, scores, deaths) drop to a scalar fix-up for the affected lanes.
+// Build with ISO -std=c++17 (no -ffast-math) so neither path contracts
+// mul+add into FMA and results stay bit-identical to SimWorld. Lanes are
+// always float: they match SimWorld::step<float>, not a
+// FLAPPY_FIXED_PHYSICS build's default.
+//
+// HitboxMode::HULL needs the bird's rotation, which follows SimBird's state
+// machine (flap / glide / fall / celebrate), so in that mode each lane keeps
+// a SimBird pose and steps through the scalar kernel; the hull test itself
+// is the AVX2 separating-axis kernel in BirdHull.
+//
+// A lane given a GapSource (FairGaps.h) takes its gap centres from it, as
+// SimWorld does, and restarts it with a seed from the lane's stream on
+// every reset.
+
+class BatchEnv {
+public:
+    // Observation layout written by observe(): OBS_SIZE floats per world
+    enum Obs { OBS_Y, OBS_VELOCITY, OBS_PIPE_X, OBS_PIPE_TOP, OBS_PIPE_BOT, OBS_SIZE };
+
+    BatchEnv(int count, Difficulty difficulty, std::uint64_t seed, float dt = 1.f / 120.f);
+
+    // actions[i] != 0 flaps world i. Fills rewards/dones; finished worlds
+    // auto-reset, so the state after step() is always a live episode.
+    void step(const std::uint8_t* actions);
+    void resetAll();
+    // Ends world i's episode between steps, as done but without the death
+    // penalty: its score is reported as the last score and it restarts
+    void truncate(int i);
+    // Takes world i out of play until resetAll: it no longer scores, dies,
+    // resets or asks its GapSource for a gap, and is not stepped at all
+    // once the rest of its group of eight is parked too
+    void park(int i);
+
+    void observe(float* out) const;
+    void setSimd(bool enabled) { useSimd = enabled; }
+    void setHitboxMode(HitboxMode mode);
+    // nullptr goes back to the uniform draw. Restarts lane i; the source
+    // must serve that lane only and outlive the env.
+    void setGapSource(int i, GapSource* source);
+    bool simdAvailable() const;
+
+    int size() const { return count; }
+    float getDt() const { return dt; }
+    const float*        getRewards() const { return reward.data(); }
+    const std::uint8_t* getDones() const { return done.data(); }
+    const int*          getLastScores() const { return lastScore.data(); }   // score of the episode that just ended
+    const float*        getBirdY() const { return y.data(); }
+    const float*        getBirdVelocity() const { return vel.data(); }
+    const int*          getScores() const { return score.data(); }
+
+    std::uint64_t getTotalSteps() const { return totalSteps; }
+    std::uint64_t getEpisodes() const { return episodes; }
+    double        getStepsPerSecond() const;
+
+private:
+    int   count;       // worlds exposed to the caller
+    int   lanes;       // count rounded up to a multiple of 8
+    float dt;
+    float width, groundY;
+    DifficultyParams base;
+    SimWorld rules;    // what a GapSource reads on restart: bounds, difficulty, start
+
+    // Bird
+    std::vector<float> y, vel;
+    // Difficulty (ramped per world) + spawning
+    std::vector<float> speed, gap, interval, spawnTimer;
+    std::vector<int>   score;
+    std::vector<Rng>   rng;
+    std::vector<GapSource*> gapSource;
+    std::vector<int>   spawned;     // pipes since the lane's reset
+    std::vector<std::uint8_t> parked;
+    int                parkedCount;
+    // Two pipe slots cover every pipe that can still touch or score: with the
+    // tightest spacing (~360 px) no third pipe reaches the bird's x-span.
+    std::vector<float> x0, top0, bot0, passed0;
+    std::vector<float> x1, top1, bot1, passed1;
+
+    // Outputs
+    std::vector<float>        reward;
+    std::vector<std::uint8_t> done;
+    std::vector<int>          lastScore;
+
+    // HULL mode only: full bird state per lane, for rotation
+    std::vector<SimBird> pose;
+
+    bool          useSimd;
+    HitboxMode    hitbox;
+    std::uint64_t totalSteps;
+    std::uint64_t episodes;
+    double        elapsed;
+
+    void resetLane(int i);
+    void spawnLane(int i);
+    void scoreLane(int i);
+    void retireLane(int i);
+    void killLane(int i);
+    bool hitsLane(int i, float px, float top, float bot, float dx, float dy) const;
+    void stepScalar(const std::uint8_t* actions);
+#if defined(__AVX2__)
+    void stepAvx2(const std::uint8_t* actions);
+#endif
+};
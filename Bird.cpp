@@ -1,12 +1,13 @@
 #include "Bird.h"
+#include "BirdHull.h"
+#include "BirdAtlas.h"
 #include <cmath>
 
 const float PI = 3.14159265f;
 
 Bird::Bird(float x, float y)
-    : velocity(0.f), gravity(1500.f), flapStrength(-520.f),
-      rotation(0.f), state(BirdState::IDLE), wingState(WingState::NEUTRAL),
-      wingTimer(0.f), wingAnimSpeed(0.08f), celebrateTimer(0.f), celebrateBounce(0.f)
+    : rotation(0.f), state(BirdState::IDLE), wingState(WingState::NEUTRAL),
+      atlas(nullptr)
 {
     position = { x, y };
     createBodyShape();
@@ -15,14 +16,19 @@ Bird::Bird(float x, float y)
     createWingShapes();
     createTailShape();
     createFeetShape();
-    updateVisuals();
+    poseWings();
+    updateTransform();
 }
 
+// Parts live in the bird's local space (origin at its centre, rotation 0);
+// only the parent transform follows the bird. Body, head and beak geometry
+// comes from BirdHull so the HULL hitbox matches what is drawn
 void Bird::createBodyShape() {
-    body.setPointCount(20);
-    float bodyW = 48.f, bodyH = 38.f;
-    for (int i = 0; i < 20; ++i) {
-        float angle = (i / 20.f) * 2.f * PI;
+    const int n = BirdHull::BODY_POINTS;
+    body.setPointCount(n);
+    float bodyW = BirdHull::BODY_W, bodyH = BirdHull::BODY_H;
+    for (int i = 0; i < n; ++i) {
+        float angle = (i / static_cast<float>(n)) * 2.f * PI;
         body.setPoint(i, sf::Vector2f(bodyW / 2.f * std::cos(angle),
                                       bodyH / 2.f * std::sin(angle)));
     }
@@ -32,48 +38,53 @@ void Bird::createBodyShape() {
 }
 
 void Bird::createHeadShape() {
-    head.setPointCount(16);
-    float headR = 22.f;
-    for (int i = 0; i < 16; ++i) {
-        float angle = (i / 16.f) * 2.f * PI;
+    const int n = BirdHull::HEAD_POINTS;
+    head.setPointCount(n);
+    float headR = BirdHull::HEAD_R;
+    for (int i = 0; i < n; ++i) {
+        float angle = (i / static_cast<float>(n)) * 2.f * PI;
         head.setPoint(i, sf::Vector2f(headR * std::cos(angle),
                                        headR * std::sin(angle)));
     }
     head.setFillColor(sf::Color(255, 230, 70));
     head.setOutlineColor(sf::Color(220, 180, 30));
     head.setOutlineThickness(2.f);
+    head.setPosition(BirdHull::HEAD_X, BirdHull::HEAD_Y);
 
     eye.setRadius(7.f);
     eye.setOrigin(7.f, 7.f);
     eye.setFillColor(sf::Color::White);
     eye.setOutlineColor(sf::Color(40, 40, 40));
     eye.setOutlineThickness(1.5f);
+    eye.setPosition(26.f, -10.f);
 
     pupil.setRadius(3.5f);
     pupil.setOrigin(3.5f, 3.5f);
     pupil.setFillColor(sf::Color(20, 20, 20));
+    pupil.setPosition(eye.getPosition() + sf::Vector2f(2.f, 0.5f));
 
     eyeGlint.setRadius(2.f);
     eyeGlint.setOrigin(2.f, 2.f);
     eyeGlint.setFillColor(sf::Color(255, 255, 255, 200));
+    eyeGlint.setPosition(pupil.getPosition() + sf::Vector2f(-1.5f, -1.5f));
 }
 
 void Bird::createBeakShape() {
     beak.setPointCount(3);
-    beak.setPoint(0, sf::Vector2f(0.f, 0.f));
-    beak.setPoint(1, sf::Vector2f(18.f, -3.f));
-    beak.setPoint(2, sf::Vector2f(18.f, 3.f));
+    for (int i = 0; i < 3; ++i)
+        beak.setPoint(i, sf::Vector2f(BirdHull::BEAK_TOP[i][0], BirdHull::BEAK_TOP[i][1]));
     beak.setFillColor(sf::Color(255, 160, 40));
     beak.setOutlineColor(sf::Color(200, 120, 20));
     beak.setOutlineThickness(1.5f);
+    beak.setPosition(BirdHull::BEAK_X, BirdHull::BEAK_Y);
 
     beakBottom.setPointCount(3);
-    beakBottom.setPoint(0, sf::Vector2f(0.f, 0.f));
-    beakBottom.setPoint(1, sf::Vector2f(14.f, 2.f));
-    beakBottom.setPoint(2, sf::Vector2f(14.f, 6.f));
+    for (int i = 0; i < 3; ++i)
+        beakBottom.setPoint(i, sf::Vector2f(BirdHull::BEAK_LOW[i][0], BirdHull::BEAK_LOW[i][1]));
     beakBottom.setFillColor(sf::Color(240, 140, 30));
     beakBottom.setOutlineColor(sf::Color(200, 120, 20));
     beakBottom.setOutlineThickness(1.5f);
+    beakBottom.setPosition(BirdHull::BEAK_X, BirdHull::BEAK_LOW_Y);
 }
 
 void Bird::createWingShapes() {
@@ -112,10 +123,17 @@ void Bird::createWingShapes() {
 
 void Bird::createTailShape() {
     for (int i = 0; i < 3; ++i) {
+        float len = 16.f - i * 2.f;
         tailFeather[i].setPointCount(4);
+        tailFeather[i].setPoint(0, sf::Vector2f(0.f, 0.f));
+        tailFeather[i].setPoint(1, sf::Vector2f(-len * 0.4f, -2.f));
+        tailFeather[i].setPoint(2, sf::Vector2f(-len, -4.f + i));
+        tailFeather[i].setPoint(3, sf::Vector2f(-len * 0.6f, 2.f));
         tailFeather[i].setFillColor(sf::Color(255, 200, 40));
         tailFeather[i].setOutlineColor(sf::Color(210, 160, 20));
         tailFeather[i].setOutlineThickness(1.5f);
+        tailFeather[i].setPosition(-20.f, -2.f + i * 2.f);
+        tailFeather[i].setRotation(-25.f + i * 25.f);
     }
 }
 
@@ -128,158 +146,30 @@ void Bird::createFeetShape() {
         foot[i].setFillColor(sf::Color(255, 140, 60));
         foot[i].setOutlineColor(sf::Color(200, 100, 30));
         foot[i].setOutlineThickness(1.f);
+        foot[i].setPosition(i == 0 ? -6.f : 6.f, 14.f);
     }
 }
 
-// ─── FIX: flap now always works unless bird is DEAD ──────────────────────
-void Bird::flap() {
-    if (state != BirdState::DEAD) {
-        // Cancel any ongoing celebration immediately
-        if (state == BirdState::CELEBRATING) {
-            celebrateTimer = 999.f; // force celebration to end
-        }
-        velocity    = flapStrength;
-        state       = BirdState::FLAPPING;
-        wingTimer   = 0.f;
-        wingState   = WingState::UP;
-    }
-}
-
-// ─── FIX: celebrate is now a SHORT visual-only effect (0.5s) ─────────────
-void Bird::celebrate() {
-    if (state == BirdState::DEAD) return;
-    state          = BirdState::CELEBRATING;
-    celebrateTimer = 0.f;
-    // Do NOT change velocity — bird keeps flying normally
-}
-
-void Bird::die() {
-    state     = BirdState::DEAD;
-    wingState = WingState::DOWN;
-}
-
-void Bird::update(float dt) {
-    updateState(dt);
-    updateWingAnimation(dt);
-
-    if (state == BirdState::CELEBRATING) {
-        celebrateTimer += dt;
-        celebrateBounce = std::sin(celebrateTimer * 10.f) * 4.f;
-
-        // ─── FIX: normal physics during celebration ───────────────────
-        velocity   += gravity * dt;
-        position.y += velocity * dt;
-
-        // Gentle wobble rotation
-        rotation = std::sin(celebrateTimer * 6.f) * 10.f;
-
-        // Auto-end celebration after 0.5 seconds → return to normal flight
-        if (celebrateTimer >= 0.5f) {
-            state    = BirdState::GLIDING;
-            rotation = 0.f;
-        }
-    } else if (state == BirdState::DEAD) {
-        velocity   += gravity * dt;
-        position.y += velocity * dt;
-        rotation   += 280.f * dt;
-        if (rotation > 90.f) rotation = 90.f;
-    } else {
-        velocity   += gravity * dt;
-        position.y += velocity * dt;
-
-        float targetRot = velocity * 0.05f;
-        if (targetRot < -30.f) targetRot = -30.f;
-        if (targetRot >  90.f) targetRot =  90.f;
-
-        float rotSpeed = (state == BirdState::FLAPPING) ? 20.f : 8.f;
-        rotation += (targetRot - rotation) * rotSpeed * dt;
-    }
-
-    updateVisuals();
-}
-
-void Bird::updateState(float dt) {
-    // ─── FIX: allow state transitions out of CELEBRATING ─────────────
-    if (state == BirdState::DEAD) return;
-    if (state == BirdState::CELEBRATING) return; // handled in update()
-
-    if (state == BirdState::FLAPPING) {
-        wingTimer += dt;
-        if (wingTimer > 0.15f) state = BirdState::GLIDING;
-    } else if (state == BirdState::GLIDING) {
-        if (velocity > 100.f) state = BirdState::FALLING;
-    } else if (state == BirdState::FALLING) {
-        if (velocity < 0.f) state = BirdState::GLIDING;
-    }
-}
-
-void Bird::updateWingAnimation(float dt) {
-    wingTimer += dt;
-
-    if (state == BirdState::CELEBRATING) {
-        if (wingTimer > wingAnimSpeed * 0.5f) {
-            wingTimer = 0.f;
-            wingState = (wingState == WingState::UP) ? WingState::DOWN : WingState::UP;
-        }
-    } else if (state == BirdState::FLAPPING) {
-        if      (wingTimer < 0.05f) wingState = WingState::UP;
-        else if (wingTimer < 0.10f) wingState = WingState::MID;
-        else                        wingState = WingState::DOWN;
-    } else if (state == BirdState::GLIDING) {
-        wingState = WingState::NEUTRAL;
-    } else if (state == BirdState::FALLING) {
-        if (wingTimer > wingAnimSpeed * 2.f) wingTimer = 0.f;
-        wingState = (wingTimer < wingAnimSpeed) ? WingState::MID : WingState::NEUTRAL;
-    } else if (state == BirdState::DEAD) {
-        wingState = WingState::DOWN;
+void Bird::sync(const SimBird& sim) {
+    position  = { sim.x, sim.y };
+    rotation  = sim.rotation;
+    state     = sim.state;
+    if (sim.wingState != wingState) {
+        wingState = sim.wingState;
+        poseWings();
     }
+    updateTransform();
 }
 
+void Bird::setAtlas(const BirdAtlas* a) { atlas = a; }
 
-void Bird::reset(float x, float y) {
-    position       = { x, y };
-    velocity       = 0.f;
-    rotation       = 0.f;
-    state          = BirdState::IDLE;
-    wingState      = WingState::NEUTRAL;
-    wingTimer      = 0.f;
-    celebrateTimer = 0.f;
-    celebrateBounce= 0.f;
-    updateVisuals();
-}
-
-sf::FloatRect Bird::getBounds() const {
-    return sf::FloatRect(position.x - 22.f, position.y - 18.f, 44.f, 36.f);
-}
-
-sf::Vector2f Bird::getRotatedOffset(float x, float y, float angle) {
-    float rad   = angle * PI / 180.f;
-    float cos_a = std::cos(rad);
-    float sin_a = std::sin(rad);
-    return sf::Vector2f(x * cos_a - y * sin_a, x * sin_a + y * cos_a);
+// One sin/cos pair per tick, shared by every part at draw time
+void Bird::updateTransform() {
+    rig = sf::Transform::Identity;
+    rig.translate(position).rotate(rotation);
 }
 
-void Bird::updateVisuals() {
-    body.setPosition(position);
-    body.setRotation(rotation);
-
-    sf::Vector2f headOff = getRotatedOffset(18.f, -5.f, rotation);
-    head.setPosition(position + headOff);
-    head.setRotation(rotation);
-
-    sf::Vector2f eyeOff = getRotatedOffset(26.f, -10.f, rotation);
-    eye.setPosition(position + eyeOff);
-    pupil.setPosition(eye.getPosition() + sf::Vector2f(2.f, 0.5f));
-    eyeGlint.setPosition(pupil.getPosition() + sf::Vector2f(-1.5f, -1.5f));
-
-    sf::Vector2f beakOff = getRotatedOffset(32.f, -5.f, rotation);
-    beak.setPosition(position + beakOff);
-    beak.setRotation(rotation);
-
-    sf::Vector2f beakBotOff = getRotatedOffset(32.f, 0.f, rotation);
-    beakBottom.setPosition(position + beakBotOff);
-    beakBottom.setRotation(rotation);
-
+void Bird::poseWings() {
     float wingAngleLeft = 0.f, wingAngleRight = 0.f;
     sf::Vector2f wingOffsetLeft(-8.f, -2.f), wingOffsetRight(8.f, 0.f);
 
@@ -297,50 +187,32 @@ void Bird::updateVisuals() {
             wingAngleLeft = 0.f; wingAngleRight = 0.f; break;
     }
 
-    sf::Vector2f wlOff = getRotatedOffset(wingOffsetLeft.x, wingOffsetLeft.y, rotation);
-    wingLeft.setPosition(position + wlOff);
-    wingLeft.setRotation(rotation + wingAngleLeft);
-
-    sf::Vector2f wrOff = getRotatedOffset(wingOffsetRight.x, wingOffsetRight.y, rotation);
-    wingRight.setPosition(position + wrOff);
-    wingRight.setRotation(rotation + wingAngleRight);
-
-    for (int i = 0; i < 3; ++i) {
-        float len = 16.f - i * 2.f;
-        tailFeather[i].setPoint(0, sf::Vector2f(0.f, 0.f));
-        tailFeather[i].setPoint(1, sf::Vector2f(-len * 0.4f, -2.f));
-        tailFeather[i].setPoint(2, sf::Vector2f(-len, -4.f + i));
-        tailFeather[i].setPoint(3, sf::Vector2f(-len * 0.6f, 2.f));
-
-        sf::Vector2f tailOff = getRotatedOffset(-20.f, -2.f + i * 2.f, rotation);
-        tailFeather[i].setPosition(position + tailOff);
-        tailFeather[i].setRotation(rotation + (-25.f + i * 25.f));
-    }
+    wingLeft.setPosition(wingOffsetLeft);
+    wingLeft.setRotation(wingAngleLeft);
+    wingRight.setPosition(wingOffsetRight);
+    wingRight.setRotation(wingAngleRight);
+}
 
-    if (state != BirdState::DEAD) {
-        for (int i = 0; i < 2; ++i) {
-            float fx = (i == 0) ? -6.f : 6.f;
-            sf::Vector2f footOff = getRotatedOffset(fx, 14.f, rotation);
-            foot[i].setPosition(position + footOff);
-            foot[i].setRotation(rotation);
-        }
+void Bird::draw(sf::RenderTarget& target) {
+    if (atlas) {
+        atlas->draw(target, position, rotation, state, wingState);
+        return;
     }
-}
+    const sf::RenderStates states(rig);
 
-void Bird::draw(sf::RenderWindow& window) {
-    for (int i = 2; i >= 0; --i) window.draw(tailFeather[i]);
+    for (int i = 2; i >= 0; --i) target.draw(tailFeather[i], states);
 
     if (state != BirdState::DEAD) {
-        for (int i = 0; i < 2; ++i) window.draw(foot[i]);
+        for (int i = 0; i < 2; ++i) target.draw(foot[i], states);
     }
 
-    window.draw(wingRight);
-    window.draw(body);
-    window.draw(wingLeft);
-    window.draw(head);
-    window.draw(beakBottom);
-    window.draw(beak);
-    window.draw(eye);
-    window.draw(pupil);
-    window.draw(eyeGlint);
+    target.draw(wingRight, states);
+    target.draw(body, states);
+    target.draw(wingLeft, states);
+    target.draw(head, states);
+    target.draw(beakBottom, states);
+    target.draw(beak, states);
+    target.draw(eye, states);
+    target.draw(pupil, states);
+    target.draw(eyeGlint, states);
 }
\ No newline at end of file
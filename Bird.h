@@ -1,63 +1,30 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "SimWorld.h"
 
-enum class BirdState {
-    IDLE,
-    FLAPPING,
-    GLIDING,
-    FALLING,
-    DEAD,
-    CELEBRATING
-};
-
-enum class WingState {
-    UP,
-    MID,
-    DOWN,
-    NEUTRAL
-};
+class BirdAtlas;
 
 class Bird {
 public:
     Bird(float x, float y);
 
-    void update(float dt);
-    void flap();
-    void draw(sf::RenderWindow& window);
-    void reset(float x, float y);
-    void celebrate();
-    void die();
-
-    // Public wing animation for menu idle animation
-    void animateWing(float dt) {
-        wingTimer += dt;
-        if (wingTimer > 0.2f) {
-            wingTimer = 0.f;
-            int next = (static_cast<int>(wingState) + 1) % 3;
-            wingState = static_cast<WingState>(next);
-        }
-    }
+    // Pull pose and animation state from the simulation. Parts stay in
+    // local space; only the parent transform (and wings, on a new wing
+    // state) change.
+    void sync(const SimBird& sim);
+    void draw(sf::RenderTarget& target);
 
-    sf::FloatRect getBounds() const;
-    float getY() const { return position.y; }
-    float getX() const { return position.x; }
-    bool isDead() const { return state == BirdState::DEAD; }
-    bool isCelebrating() const { return state == BirdState::CELEBRATING; }
+    // Draw from a pre-baked atlas as one quad; nullptr draws the shapes
+    void setAtlas(const BirdAtlas* a);
 
 private:
     sf::Vector2f position;
-    float velocity;
-    float gravity;
-    float flapStrength;
     float rotation;
-    
     BirdState state;
     WingState wingState;
-    float wingTimer;
-    float wingAnimSpeed;
-    float celebrateTimer;
-    float celebrateBounce;
-    
+    const BirdAtlas* atlas;
+    sf::Transform rig;   // local -> world: translate(position), rotate(rotation)
+
     // Body parts with more realistic proportions
     sf::ConvexShape body;
     sf::ConvexShape head;
@@ -78,11 +45,8 @@ private:
     // Feet
     sf::ConvexShape foot[2];
     
-    void updateVisuals();
-    void updateWingAnimation(float dt);
-    void updateState(float dt);
-    void drawRealisticBird(sf::RenderWindow& window);
-    sf::Vector2f getRotatedOffset(float x, float y, float angle);
+    void updateTransform();
+    void poseWings();
     void createBodyShape();
     void createHeadShape();
     void createBeakShape();
@@ -0,0 +1,88 @@
+#include "BirdAtlas.h"
+#include "Bird.h"
+#include <algorithm>
+#include <cmath>
+
+// The rig renders into a transparent canvas with normal alpha blending,
+// which leaves colour multiplied by coverage; drawing it back needs One
+const sf::BlendMode BirdAtlas::BLEND(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);
+
+BirdAtlas::BirdAtlas() : ready(false) {}
+
+bool BirdAtlas::build() {
+    const int cells = POSES * ROT_BUCKETS;
+    const unsigned w = static_cast<unsigned>(COLUMNS * CELL);
+    const unsigned h = static_cast<unsigned>((cells + COLUMNS - 1) / COLUMNS * CELL);
+    ready = false;
+    if (w > sf::Texture::getMaximumSize() || h > sf::Texture::getMaximumSize()) return false;
+    if (!canvas.create(w, h)) return false;
+
+    canvas.clear(sf::Color::Transparent);
+    Bird rig(0.f, 0.f);
+    for (int pose = 0; pose < POSES; ++pose) {
+        for (int b = 0; b < ROT_BUCKETS; ++b) {
+            SimBird s(cellOrigin(pose, b).x + CELL * 0.5f, cellOrigin(pose, b).y + CELL * 0.5f);
+            s.rotation  = ROT_MIN + b * ROT_STEP;
+            s.state     = pose == POSES - 1 ? BirdState::DEAD : BirdState::IDLE;
+            s.wingState = pose == POSES - 1 ? WingState::DOWN : static_cast<WingState>(pose);
+            rig.sync(s);
+            rig.draw(canvas);
+        }
+    }
+    canvas.display();
+    canvas.setSmooth(true);
+    ready = true;
+    return true;
+}
+
+// Dead birds always have their wings down and no feet
+int BirdAtlas::poseFor(BirdState state, WingState wings) {
+    return state == BirdState::DEAD ? POSES - 1 : static_cast<int>(wings);
+}
+
+int BirdAtlas::bucketFor(float rotation) {
+    const int b = static_cast<int>(std::lround((rotation - ROT_MIN) / ROT_STEP));
+    return std::min(std::max(b, 0), ROT_BUCKETS - 1);
+}
+
+sf::Vector2f BirdAtlas::cellOrigin(int pose, int bucket) {
+    const int i = pose * ROT_BUCKETS + bucket;
+    return sf::Vector2f(static_cast<float>(i % COLUMNS * CELL), static_cast<float>(i / COLUMNS * CELL));
+}
+
+void BirdAtlas::writeQuad(sf::Vertex* quad, sf::Vector2f position, float rotation,
+                          BirdState state, WingState wings) const {
+    const int b = bucketFor(rotation);
+    const sf::Vector2f tex = cellOrigin(poseFor(state, wings), b);
+
+    sf::Transform t;
+    t.translate(position).rotate(rotation - (ROT_MIN + b * ROT_STEP));
+    const float half = CELL * 0.5f;
+    const sf::Vector2f corner[4] = { { -half, -half }, { half, -half }, { half, half }, { -half, half } };
+    for (int i = 0; i < 4; ++i) {
+        quad[i].position  = t.transformPoint(corner[i]);
+        quad[i].texCoords = tex + corner[i] + sf::Vector2f(half, half);
+        quad[i].color     = sf::Color::White;
+    }
+}
+
+void BirdAtlas::appendQuad(sf::VertexArray& quads, const SimBird& bird) const {
+    sf::Vertex quad[4];
+    writeQuad(quad, sf::Vector2f(bird.x, bird.y), bird.rotation, bird.state, bird.wingState);
+    for (int i = 0; i < 4; ++i) quads.append(quad[i]);
+}
+
+void BirdAtlas::draw(sf::RenderTarget& target, const sf::VertexArray& quads) const {
+    sf::RenderStates states(BLEND);
+    states.texture = &canvas.getTexture();
+    target.draw(quads, states);
+}
+
+void BirdAtlas::draw(sf::RenderTarget& target, sf::Vector2f position, float rotation,
+                     BirdState state, WingState wings) const {
+    sf::Vertex quad[4];
+    writeQuad(quad, position, rotation, state, wings);
+    sf::RenderStates states(BLEND);
+    states.texture = &canvas.getTexture();
+    target.draw(quad, 4, sf::Quads, states);
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "SimWorld.h"
+
+// ─── Bird sprite atlas ────────────────────────────────────────────────────
+// The vector rig (Bird) rasterized once at startup: one cell per pose
+// (the four wing states alive, plus dead) and per rotation bucket. A bird
+// is then one textured quad, turned by the two degrees or less left between
+// its rotation and the bucket's, so any number of birds sharing the atlas
+// (ghost replays, flocks) go out in a single draw call.
+//
+// Cells hold premultiplied alpha, so quads are drawn with BLEND.
+
+class BirdAtlas {
+public:
+    static constexpr float ROT_MIN     = -32.f;   // same range as BirdHull
+    static constexpr float ROT_STEP    = 4.f;
+    static constexpr int   ROT_BUCKETS = 32;
+    static constexpr int   POSES       = 5;       // WingState UP..NEUTRAL, then DEAD
+    static constexpr int   CELL        = 128;     // px; the rig reaches ~52 px from its centre
+    static constexpr int   COLUMNS     = 16;
+
+    static const sf::BlendMode BLEND;
+
+    BirdAtlas();
+
+    // Needs a GL context (create the window first). False if the GPU cannot
+    // hold the atlas; callers then keep drawing the vector rig.
+    bool build();
+    bool isReady() const { return ready; }
+
+    // One quad (four vertices) per bird, to batch many into one draw
+    void appendQuad(sf::VertexArray& quads, const SimBird& bird) const;
+    void draw(sf::RenderTarget& target, const sf::VertexArray& quads) const;
+    void draw(sf::RenderTarget& target, sf::Vector2f position, float rotation,
+              BirdState state, WingState wings) const;
+
+    const sf::Texture& getTexture() const { return canvas.getTexture(); }
+
+private:
+    sf::RenderTexture canvas;
+    bool ready;
+
+    static int  poseFor(BirdState state, WingState wings);
+    static int  bucketFor(float rotation);
+    static sf::Vector2f cellOrigin(int pose, int bucket);
+    void writeQuad(sf::Vertex* quad, sf::Vector2f position, float rotation,
+                   BirdState state, WingState wings) const;
+};
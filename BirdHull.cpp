@@ -0,0 +1,185 @@
+#include "BirdHull.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+struct Pt { float x, y; };
+
+const float PI = 3.14159265f;
+
+// Same transform as the Bird rig's parent (translate, then rotate): part
+// offset and part points rotate together about the bird's centre
+Pt rotate(float x, float y, float deg) {
+    float rad = deg * PI / 180.f;
+    float c = std::cos(rad), s = std::sin(rad);
+    return Pt{ x * c - y * s, x * s + y * c };
+}
+
+// Monotone chain; points come back counter-clockwise without repeats
+std::vector<Pt> convexHull(std::vector<Pt> pts) {
+    std::sort(pts.begin(), pts.end(),
+        [](const Pt& a, const Pt& b){ return a.x < b.x || (a.x == b.x && a.y < b.y); });
+    auto cross = [](const Pt& o, const Pt& a, const Pt& b) {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    };
+    std::vector<Pt> hull(pts.size() * 2);
+    size_t k = 0;
+    for (size_t i = 0; i < pts.size(); ++i) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], pts[i]) <= 0.f) --k;
+        hull[k++] = pts[i];
+    }
+    for (size_t i = pts.size() - 1, t = k + 1; i > 0; --i) {
+        while (k >= t && cross(hull[k - 2], hull[k - 1], pts[i - 1]) <= 0.f) --k;
+        hull[k++] = pts[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+} // namespace
+
+const BirdHull& BirdHull::instance() {
+    static const BirdHull hull;
+    return hull;
+}
+
+int BirdHull::bucketFor(float rotation) {
+    int b = static_cast<int>(std::floor((rotation - ROT_MIN) / ROT_STEP + 0.5f));
+    return std::min(std::max(b, 0), ROT_BUCKETS - 1);
+}
+
+BirdHull::BirdHull() : reach(0.f) {
+    for (int k = 0; k < ROT_BUCKETS; ++k) {
+        const float deg = ROT_MIN + k * ROT_STEP;
+        std::vector<Pt> parts[PARTS];
+
+        for (int i = 0; i < BODY_POINTS; ++i) {
+            float a = (i / static_cast<float>(BODY_POINTS)) * 2.f * PI;
+            parts[0].push_back(rotate(BODY_W / 2.f * std::cos(a), BODY_H / 2.f * std::sin(a), deg));
+        }
+        for (int i = 0; i < HEAD_POINTS; ++i) {
+            float a = (i / static_cast<float>(HEAD_POINTS)) * 2.f * PI;
+            parts[1].push_back(rotate(HEAD_X + HEAD_R * std::cos(a), HEAD_Y + HEAD_R * std::sin(a), deg));
+        }
+        for (int i = 0; i < 3; ++i) {
+            parts[2].push_back(rotate(BEAK_X + BEAK_TOP[i][0], BEAK_Y + BEAK_TOP[i][1], deg));
+            parts[2].push_back(rotate(BEAK_X + BEAK_LOW[i][0], BEAK_LOW_Y + BEAK_LOW[i][1], deg));
+        }
+
+        Bucket& bucket = buckets[k];
+        float minX = 0.f, maxX = 0.f, minY = 0.f, maxY = 0.f;
+        for (int p = 0; p < PARTS; ++p) {
+            std::vector<Pt> hull = convexHull(parts[p]);
+
+            // x and y first (the pipe rect's own axes), then one normal per
+            // distinct edge direction
+            std::vector<Pt> axes = { { 1.f, 0.f }, { 0.f, 1.f } };
+            for (size_t i = 0; i < hull.size(); ++i) {
+                const Pt& a = hull[i];
+                const Pt& b = hull[(i + 1) % hull.size()];
+                Pt n{ -(b.y - a.y), b.x - a.x };
+                float len = std::sqrt(n.x * n.x + n.y * n.y);
+                if (len < 1e-6f) continue;
+                n.x /= len; n.y /= len;
+                bool parallel = false;
+                for (const Pt& m : axes)
+                    if (std::fabs(n.x * m.y - n.y * m.x) < 1e-4f) { parallel = true; break; }
+                if (!parallel) axes.push_back(n);
+            }
+
+            Part& part = bucket.parts[p];
+            for (int i = 0; i < MAX_AXES; ++i) {
+                // Padding repeats the last axis
+                const Pt& n = axes[std::min<size_t>(static_cast<size_t>(i), axes.size() - 1)];
+                float lo = INFINITY, hi = -INFINITY;
+                for (const Pt& v : hull) {
+                    float d = n.x * v.x + n.y * v.y;
+                    lo = std::min(lo, d);
+                    hi = std::max(hi, d);
+                }
+                part.nx[i] = n.x;  part.ny[i] = n.y;
+                part.pmin[i] = lo; part.pmax[i] = hi;
+            }
+            // Axes 0 and 1 are x and y, so they hold the part's bounds
+            minX = std::min(minX, part.pmin[0]); maxX = std::max(maxX, part.pmax[0]);
+            minY = std::min(minY, part.pmin[1]); maxY = std::max(maxY, part.pmax[1]);
+            for (const Pt& v : hull) reach = std::max(reach, std::sqrt(v.x * v.x + v.y * v.y));
+        }
+        bucket.bounds = SimRect{ minX, minY, maxX - minX, maxY - minY };
+    }
+}
+
+// One part against a rect centred (cx, cy) relative to the bird with half
+// extents (hx, hy). Per axis the overlap is an open interval of u (time
+// measured back from the end of the step, position(u) = end - u * d), in
+// the same form as Collision.h's sweepSlab; the intervals are intersected
+// with [0, 1], seeded into lo/hi.
+bool BirdHull::partHits(const Part& p, float cx, float cy, float hx, float hy, float dx, float dy) {
+#if defined(__AVX2__)
+    const __m256 vcx = _mm256_set1_ps(cx), vcy = _mm256_set1_ps(cy);
+    const __m256 vhx = _mm256_set1_ps(hx), vhy = _mm256_set1_ps(hy);
+    const __m256 vdx = _mm256_set1_ps(dx), vdy = _mm256_set1_ps(dy);
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 abs = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 lo = _mm256_setzero_ps();
+    __m256 hi = one;
+    for (int i = 0; i < MAX_AXES; i += 8) {
+        __m256 nx  = _mm256_load_ps(p.nx + i);
+        __m256 ny  = _mm256_load_ps(p.ny + i);
+        __m256 cp  = _mm256_add_ps(_mm256_mul_ps(nx, vcx), _mm256_mul_ps(ny, vcy));
+        __m256 rad = _mm256_add_ps(_mm256_mul_ps(_mm256_and_ps(nx, abs), vhx),
+                                   _mm256_mul_ps(_mm256_and_ps(ny, abs), vhy));
+        __m256 s   = _mm256_add_ps(_mm256_mul_ps(nx, vdx), _mm256_mul_ps(ny, vdy));
+        __m256 inv = _mm256_div_ps(one, s);
+        __m256 a   = _mm256_mul_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_load_ps(p.pmin + i), cp), rad), inv);
+        __m256 b   = _mm256_mul_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_load_ps(p.pmax + i), cp), rad), inv);
+        lo = _mm256_max_ps(lo, _mm256_min_ps(a, b));
+        hi = _mm256_min_ps(hi, _mm256_max_ps(a, b));
+    }
+    alignas(32) float l[8], h[8];
+    _mm256_store_ps(l, lo);
+    _mm256_store_ps(h, hi);
+    float L = l[0], U = h[0];
+    for (int i = 1; i < 8; ++i) {
+        L = L > l[i] ? L : l[i];
+        U = U < h[i] ? U : h[i];
+    }
+    return L < U;
+#else
+    float L = 0.f, U = 1.f;
+    for (int i = 0; i < MAX_AXES; ++i) {
+        float cp  = p.nx[i] * cx + p.ny[i] * cy;
+        float rad = std::fabs(p.nx[i]) * hx + std::fabs(p.ny[i]) * hy;
+        float s   = p.nx[i] * dx + p.ny[i] * dy;
+        float inv = 1.f / s;
+        float a   = ((p.pmin[i] - cp) - rad) * inv;
+        float b   = ((p.pmax[i] - cp) + rad) * inv;
+        float mn  = a < b ? a : b;
+        float mx  = a > b ? a : b;
+        L = L > mn ? L : mn;
+        U = U < mx ? U : mx;
+    }
+    return L < U;
+#endif
+}
+
+bool BirdHull::hitsRect(float x, float y, float rotation, float dx, float dy, const SimRect& r) const {
+    const Bucket& b = buckets[bucketFor(rotation)];
+
+    // Reject on the bounds swept over the step before touching the axes
+    float endL = x + b.bounds.left, endT = y + b.bounds.top;
+    float l = std::min(endL, endL - dx), t = std::min(endT, endT - dy);
+    SimRect swept{ l, t, b.bounds.width + std::fabs(dx), b.bounds.height + std::fabs(dy) };
+    if (!swept.intersects(r)) return false;
+
+    const float hx = r.width * 0.5f, hy = r.height * 0.5f;
+    const float cx = (r.left + hx) - x, cy = (r.top + hy) - y;
+    for (int p = 0; p < PARTS; ++p)
+        if (partHits(b.parts[p], cx, cy, hx, hy, dx, dy)) return true;
+    return false;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "SimWorld.h"
+
+// ─── Bird hitbox hulls ────────────────────────────────────────────────────
+// Convex hulls of the drawn bird, precomputed per rotation bucket as
+// separating-axis tables (one axis per distinct edge normal, plus x and y).
+// A test against a pipe rect is a swept SAT: every axis yields the part of
+// the step during which the projections overlap, and the bird touched the
+// rect if those intervals share a moment. Axes are evaluated 8 at a time
+// with AVX2 when the build enables it.
+class BirdHull {
+public:
+    // Local geometry (beak along +x, y down), shared with Bird's shapes
+    static constexpr float BODY_W      = 48.f;
+    static constexpr float BODY_H      = 38.f;
+    static constexpr int   BODY_POINTS = 20;
+    static constexpr float HEAD_R      = 22.f;
+    static constexpr int   HEAD_POINTS = 16;
+    static constexpr float HEAD_X      = 18.f;
+    static constexpr float HEAD_Y      = -5.f;
+    static constexpr float BEAK_X      = 32.f;
+    static constexpr float BEAK_Y      = -5.f;    // upper beak
+    static constexpr float BEAK_LOW_Y  = 0.f;     // lower beak
+    static constexpr float BEAK_TOP[3][2] = { { 0.f, 0.f }, { 18.f, -3.f }, { 18.f, 3.f } };
+    static constexpr float BEAK_LOW[3][2] = { { 0.f, 0.f }, { 14.f,  2.f }, { 14.f, 6.f } };
+
+    // Rotation buckets cover the bird's whole range (-30° climbing to 90°
+    // nose-down, ±10° celebration wobble)
+    static constexpr float ROT_MIN     = -32.f;
+    static constexpr float ROT_STEP    = 2.f;
+    static constexpr int   ROT_BUCKETS = 64;
+    static constexpr int   PARTS       = 3;
+    static constexpr int   MAX_AXES    = 16;   // per part, padded to a multiple of 8
+
+    // Built on first use; read-only afterwards, so safe to share across threads
+    static const BirdHull& instance();
+
+    // True if the bird, ending the step at (x, y) with `rotation` after
+    // moving (dx, dy) relative to r during it, touched r at any point
+    bool hitsRect(float x, float y, float rotation, float dx, float dy, const SimRect& r) const;
+
+    // Bounds of all parts relative to the bird for a rotation
+    const SimRect& getBounds(float rotation) const { return buckets[bucketFor(rotation)].bounds; }
+    // Farthest point of any part from the bird's centre, over all rotations
+    float getReach() const { return reach; }
+
+    static int bucketFor(float rotation);
+
+private:
+    struct Part {
+        alignas(32) float nx[MAX_AXES];
+        alignas(32) float ny[MAX_AXES];
+        alignas(32) float pmin[MAX_AXES];   // hull projection, relative to the bird
+        alignas(32) float pmax[MAX_AXES];
+    };
+    struct Bucket {
+        Part    parts[PARTS];
+        SimRect bounds;
+    };
+
+    Bucket buckets[ROT_BUCKETS];
+    float  reach;
+
+    BirdHull();
+    static bool partHits(const Part& p, float cx, float cy, float hx, float hy, float dx, float dy);
+};
@@ -0,0 +1,81 @@
+#include "Brain.h"
+#include "Collision.h"
+#include <algorithm>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// tanh(x) ~ x (27 + x²) / (27 + 9x²), exact ±1 at |x| = 3
+static inline float tanhApprox(float x) {
+    x = std::min(std::max(x, -3.f), 3.f);
+    const float x2 = x * x;
+    return (x * (27.f + x2)) / (27.f + 9.f * x2);
+}
+
+void Brain::observe(const SimWorld& world, float* in) {
+    const SimBird& bird = world.getBird();
+    const float    left = bird.getBounds().left;
+    const float    groundY = world.getGroundY();
+
+    // First pipe the bird has not yet flown past; with none on screen the
+    // gap is taken as far ahead and level with mid-air
+    float gapX = world.getWidth();
+    float gapY = groundY * 0.5f;
+    const PipeRing& pipes = world.getPipes();
+    for (int i = 0; i < pipes.size(); ++i) {
+        if (pipeRight(pipes[i].x) <= left) continue;
+        gapX = pipeRight(pipes[i].x) - bird.x;
+        gapY = (pipes[i].topY + pipes[i].botY) * 0.5f;
+        break;
+    }
+    in[IN_Y]        = bird.y / groundY;
+    in[IN_VELOCITY] = bird.velocity / 1000.f;
+    in[IN_GAP_X]    = gapX / world.getWidth();
+    in[IN_GAP_Y]    = (gapY - bird.y) / 200.f;
+}
+
+float Brain::forward(const float* g, const float* in) {
+    alignas(32) float h[HIDDEN];
+#if defined(__AVX2__)
+    __m256 acc[HIDDEN / 8];
+    for (int k = 0; k < HIDDEN / 8; ++k) acc[k] = _mm256_loadu_ps(g + B_HIDDEN + 8 * k);
+    for (int i = 0; i < INPUTS; ++i) {
+        const __m256 x = _mm256_set1_ps(in[i]);
+        for (int k = 0; k < HIDDEN / 8; ++k)
+            acc[k] = _mm256_add_ps(acc[k], _mm256_mul_ps(x, _mm256_loadu_ps(g + W_HIDDEN + i * HIDDEN + 8 * k)));
+    }
+    const __m256 lim = _mm256_set1_ps(3.f);
+    const __m256 c27 = _mm256_set1_ps(27.f);
+    const __m256 c9  = _mm256_set1_ps(9.f);
+    for (int k = 0; k < HIDDEN / 8; ++k) {
+        const __m256 x  = _mm256_min_ps(_mm256_max_ps(acc[k], _mm256_sub_ps(_mm256_setzero_ps(), lim)), lim);
+        const __m256 x2 = _mm256_mul_ps(x, x);
+        const __m256 num = _mm256_mul_ps(x, _mm256_add_ps(c27, x2));
+        const __m256 den = _mm256_add_ps(c27, _mm256_mul_ps(c9, x2));
+        _mm256_store_ps(h + 8 * k, _mm256_div_ps(num, den));
+    }
+#else
+    for (int j = 0; j < HIDDEN; ++j) h[j] = g[B_HIDDEN + j];
+    for (int i = 0; i < INPUTS; ++i)
+        for (int j = 0; j < HIDDEN; ++j) h[j] += in[i] * g[W_HIDDEN + i * HIDDEN + j];
+    for (int j = 0; j < HIDDEN; ++j) h[j] = tanhApprox(h[j]);
+#endif
+    // The output sum stays scalar in both builds so its order is fixed
+    float out = g[B_OUT];
+    for (int j = 0; j < HIDDEN; ++j) out += h[j] * g[W_OUT + j];
+    return out;
+}
+
+bool Brain::decide(const float* genome, const SimWorld& world) {
+    float in[INPUTS];
+    observe(world, in);
+    return forward(genome, in) > 0.f;
+}
+
+bool Brain::simdAvailable() {
+#if defined(__AVX2__)
+    return true;
+#else
+    return false;
+#endif
+}
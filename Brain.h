@@ -0,0 +1,38 @@
+#pragma once
+#include "SimWorld.h"
+
+// ─── Neural bird controller ───────────────────────────────────────────────
+// A small feed-forward net: INPUTS observations of the world, HIDDEN tanh
+// units, one output; the bird flaps when the output is positive.
+//
+// A genome is the net's weights packed into one GENOME_STRIDE-float block:
+//   hidden weights, input-major (one row of HIDDEN per input, so a row is
+//   whole AVX2 registers), hidden biases, output weights, output bias,
+//   zero padding to a multiple of 8.
+// A population is these blocks back to back in one array.
+//
+// The AVX2 and scalar passes do the same multiplies and adds in the same
+// order (tanh is a rational approximation, not libm), so a genome flies
+// the same on either build.
+
+struct Brain {
+    enum Input { IN_Y, IN_VELOCITY, IN_GAP_X, IN_GAP_Y, INPUTS };
+
+    static constexpr int HIDDEN = 16;
+    static_assert(HIDDEN % 8 == 0, "hidden rows must be whole AVX2 registers");
+
+    static constexpr int W_HIDDEN      = 0;
+    static constexpr int B_HIDDEN      = W_HIDDEN + INPUTS * HIDDEN;
+    static constexpr int W_OUT         = B_HIDDEN + HIDDEN;
+    static constexpr int B_OUT         = W_OUT + HIDDEN;
+    static constexpr int GENOME_SIZE   = B_OUT + 1;
+    static constexpr int GENOME_STRIDE = (GENOME_SIZE + 7) & ~7;
+
+    // Bird height and velocity, and the next gap the bird has not cleared,
+    // all scaled to roughly [-1, 1]
+    static void  observe(const SimWorld& world, float* in);
+    static float forward(const float* genome, const float* in);
+    static bool  decide(const float* genome, const SimWorld& world);
+
+    static bool simdAvailable();
+};
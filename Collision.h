@@ -0,0 +1,107 @@
+#pragma once
+#include "SimWorld.h"
+#include "BirdHull.h"
+
+// ─── Bird vs pipe collision ───────────────────────────────────────────────
+// Shared by SimWorld and BatchEnv so both evaluate the same float
+// expressions in the same order and stay bit-identical. The box tests are
+// templates over the scalar so SimWorld can run them in Fixed as well.
+
+// The four outlined rects a Pipe draws. getGlobalBounds() includes the
+// outline, so every rect is grown by PIPE_OUTLINE on each side.
+template <class Real>
+struct BasicPipeRects {
+    BasicSimRect<Real> topBody, topCap, botBody, botCap;
+};
+using PipeRects = BasicPipeRects<float>;
+
+template <class Real>
+inline BasicPipeRects<Real> pipeRects(Real x, Real topY, Real botY, Real groundY) {
+    const Real o    = Real(SimWorld::PIPE_OUTLINE);
+    const Real W    = Real(SimWorld::PIPE_WIDTH);
+    const Real CH   = Real(SimWorld::PIPE_CAP_H);
+    const Real two  = Real(2.f);
+    const Real capX = x - Real(SimWorld::PIPE_CAP_OVERHANG);
+    const Real capW = W + two * Real(SimWorld::PIPE_CAP_OVERHANG);
+
+    BasicPipeRects<Real> r;
+    r.topBody = BasicSimRect<Real>{ x - o,    -o,             W + two*o,    topY + two*o };
+    r.topCap  = BasicSimRect<Real>{ capX - o, topY - CH - o,  capW + two*o, CH + two*o };
+    r.botBody = BasicSimRect<Real>{ x - o,    botY - o,       W + two*o,    (groundY - botY) + two*o };
+    r.botCap  = BasicSimRect<Real>{ capX - o, botY - o,       capW + two*o, CH + two*o };
+    return r;
+}
+
+// Horizontal extent of a pipe including caps and outline (the widest rects)
+template <class Real>
+inline Real pipeLeft(Real x) { return (x - Real(SimWorld::PIPE_CAP_OVERHANG)) - Real(SimWorld::PIPE_OUTLINE); }
+template <class Real>
+inline Real pipeRight(Real x) {
+    const Real two = Real(2.f);
+    return pipeLeft(x) + ((Real(SimWorld::PIPE_WIDTH) + two * Real(SimWorld::PIPE_CAP_OVERHANG)) +
+                          two * Real(SimWorld::PIPE_OUTLINE));
+}
+
+template <class Real>
+inline bool boxHitsPipe(const BasicSimRect<Real>& bb, const BasicPipeRects<Real>& r) {
+    return bb.intersects(r.topBody) || bb.intersects(r.botBody) ||
+           bb.intersects(r.topCap)  || bb.intersects(r.botCap);
+}
+
+// ─── Swept test ───────────────────────────────────────────────────────────
+// In the pipe's frame the bird box travels in a straight line during a
+// step: it ends at `box` and started (dx, dy) earlier, where dx is the
+// pipe scroll (speed * dt) and dy the bird's vertical move. With u in
+// [0, 1] measured back from the end, position(u) = end - u * d, so each
+// axis overlaps for u in an open interval; the box touched the rect at
+// some point of the step if both intervals meet inside [0, 1].
+// Callers pass 1/dx and 1/dy; a zero displacement gives ±inf and the
+// ternaries below drop the NaN from 0 * inf, exactly as minps/maxps do.
+// Fixed has no infinity: its 1/0 is 0, and the overload below gives that
+// axis the same answer float does (overlap throughout, strictly inside).
+
+inline void sweepSlab(float p, float lo, float hi, float inv, float& uMin, float& uMax) {
+    float a = (p - hi) * inv;
+    float b = (p - lo) * inv;
+    uMin = a < b ? a : b;
+    uMax = a > b ? a : b;
+}
+
+inline void sweepSlab(Fixed p, Fixed lo, Fixed hi, Fixed inv, Fixed& uMin, Fixed& uMax) {
+    if (inv == Fixed::fromRaw(0)) {
+        const bool inside = lo < p && p < hi;
+        uMin = inside ? Fixed::lowest() : Fixed::highest();
+        uMax = Fixed::highest();
+        return;
+    }
+    Fixed a = (p - hi) * inv;
+    Fixed b = (p - lo) * inv;
+    uMin = a < b ? a : b;
+    uMax = a > b ? a : b;
+}
+
+template <class Real>
+inline bool sweptIntersects(const BasicSimRect<Real>& box, Real invDx, Real invDy, const BasicSimRect<Real>& r) {
+    Real x0, x1, y0, y1;
+    sweepSlab(box.left, r.left - box.width,  r.left + r.width,  invDx, x0, x1);
+    sweepSlab(box.top,  r.top  - box.height, r.top  + r.height, invDy, y0, y1);
+    Real lo = x0 > y0 ? x0 : y0;
+    Real hi = x1 < y1 ? x1 : y1;
+    return lo < hi && lo < Real(1.f) && hi > Real(0.f);
+}
+
+template <class Real>
+inline bool sweptHitsPipe(const BasicSimRect<Real>& bb, Real invDx, Real invDy, const BasicPipeRects<Real>& r) {
+    return sweptIntersects(bb, invDx, invDy, r.topBody) || sweptIntersects(bb, invDx, invDy, r.botBody) ||
+           sweptIntersects(bb, invDx, invDy, r.topCap)  || sweptIntersects(bb, invDx, invDy, r.botCap);
+}
+
+// HULL mode: the rotated body / head / beak, swept over the step. Pipes
+// clear of the hull's reach (the caps are the widest rects) skip the SAT.
+inline bool hullHitsPipe(float x, float y, float rotation, float dx, float dy, const PipeRects& r) {
+    const BirdHull& h = BirdHull::instance();
+    const float reach = h.getReach() + 1.f;
+    if (r.topCap.left >= x + reach || r.topCap.left + r.topCap.width <= x - reach - dx) return false;
+    return h.hitsRect(x, y, rotation, dx, dy, r.topBody) || h.hitsRect(x, y, rotation, dx, dy, r.botBody) ||
+           h.hitsRect(x, y, rotation, dx, dy, r.topCap)  || h.hitsRect(x, y, rotation, dx, dy, r.botCap);
+}
@@ -0,0 +1,258 @@
+#include "Evolution.h"
+#include "Collision.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+// ─── Population ───────────────────────────────────────────────────────────
+Population::Population(const EvolutionParams& p)
+    : params(p), generation(0),
+      genes(static_cast<std::size_t>(p.population) * Brain::GENOME_STRIDE, 0.f),
+      spare(genes.size(), 0.f),
+      evals(static_cast<std::size_t>(p.population), Evaluation{ 0.f, 0, 0 }),
+      champion(Brain::GENOME_STRIDE, 0.f), championFitness(-INFINITY)
+{
+    params.elite      = std::min(std::max(params.elite, 0), params.population);
+    params.tournament = std::max(params.tournament, 1);
+}
+
+void Population::randomize() {
+    Rng rng(params.seed * 1000003ull, RNG_STREAM_EVOLUTION);
+    for (int i = 0; i < params.population; ++i) {
+        float* g = genome(i);
+        for (int k = 0; k < Brain::GENOME_SIZE; ++k) g[k] = rng.uniform(-1.f, 1.f);
+    }
+    generation = 0;
+    championFitness = -INFINITY;
+}
+
+// Every genome of a generation meets the same courses, and each generation
+// new ones, so selection rewards flying rather than one lucky layout
+std::uint64_t Population::courseSeed(int episode) const {
+    return params.seed * 1000003ull + static_cast<std::uint64_t>(generation) * static_cast<std::uint64_t>(params.episodes) +
+           static_cast<std::uint64_t>(episode);
+}
+
+Evaluation Population::fly(const float* g, SimWorld& world, std::uint64_t seed, float dt, std::uint32_t maxTicks) {
+    world.reset(seed);
+    unsigned events = SIM_NONE;
+    while (!(events & SIM_DIED) && !world.isOver() && world.getTick() < maxTicks) {
+        if (Brain::decide(g, world)) world.flap();
+        events = world.step(dt);
+    }
+    const SimBird& bird = world.getBird();
+    float miss = 0.f;
+    if (bird.isDead()) {
+        // Distance to the gap it died at (or the next one), as a share of
+        // the sky: the gradient that gets generation 0 through pipe one
+        const PipeRing& pipes = world.getPipes();
+        const float left = bird.getBounds().left;
+        for (int i = 0; i < pipes.size(); ++i) {
+            if (pipeRight(pipes[i].x) <= left) continue;
+            miss = std::fabs((pipes[i].topY + pipes[i].botY) * 0.5f - bird.y) / world.getGroundY();
+            break;
+        }
+    }
+    const float seconds = static_cast<float>(world.getTick()) * dt;
+    return Evaluation{ seconds + PIPE_BONUS * static_cast<float>(world.getScore()) - miss,
+                       world.getScore(), world.getTick() };
+}
+
+void Population::evaluate(WorkPool& pool) {
+    const float dt = 1.f / static_cast<float>(params.tickRate);
+    const std::uint32_t maxTicks = static_cast<std::uint32_t>(params.maxSeconds * static_cast<float>(params.tickRate));
+
+    std::vector<SimWorld> worlds;
+    worlds.reserve(pool.size());
+    for (unsigned w = 0; w < pool.size(); ++w) {
+        worlds.emplace_back(600.f, 800.f);
+        worlds.back().setDifficulty(DifficultyParams::forLevel(params.difficulty));
+        worlds.back().setHitboxMode(params.hitbox);
+    }
+
+    pool.run(params.population, [&](int i, unsigned worker) {
+        Evaluation total{ 0.f, 0, 0 };
+        for (int e = 0; e < params.episodes; ++e) {
+            Evaluation ep = fly(genome(i), worlds[worker], courseSeed(e), dt, maxTicks);
+            total.fitness  += ep.fitness;
+            total.bestScore = std::max(total.bestScore, ep.bestScore);
+            total.ticks    += ep.ticks;
+        }
+        total.fitness /= static_cast<float>(std::max(params.episodes, 1));
+        evals[static_cast<std::size_t>(i)] = total;
+    });
+
+    const int best = getBestIndex();
+    if (evals[static_cast<std::size_t>(best)].fitness > championFitness) {
+        championFitness = evals[static_cast<std::size_t>(best)].fitness;
+        std::copy(genome(best), genome(best) + Brain::GENOME_STRIDE, champion.begin());
+    }
+}
+
+int Population::getBestIndex() const {
+    int best = 0;
+    for (int i = 1; i < params.population; ++i)
+        if (evals[static_cast<std::size_t>(i)].fitness > evals[static_cast<std::size_t>(best)].fitness) best = i;
+    return best;
+}
+
+float Population::getMeanFitness() const {
+    double sum = 0.0;
+    for (const Evaluation& e : evals) sum += e.fitness;
+    return static_cast<float>(sum / static_cast<double>(evals.size()));
+}
+
+void Population::breed() {
+    Rng rng(params.seed * 1000003ull + static_cast<std::uint64_t>(generation) + 1, RNG_STREAM_EVOLUTION);
+    const int n = params.population;
+
+    // Rank by fitness; ties keep index order so the result is stable
+    std::vector<int> rank(static_cast<std::size_t>(n));
+    std::iota(rank.begin(), rank.end(), 0);
+    std::stable_sort(rank.begin(), rank.end(), [this](int a, int b) {
+        return evals[static_cast<std::size_t>(a)].fitness > evals[static_cast<std::size_t>(b)].fitness;
+    });
+    auto pick = [&]() {
+        int best = rng.below(n);
+        for (int t = 1; t < params.tournament; ++t) {
+            int c = rng.below(n);
+            if (evals[static_cast<std::size_t>(c)].fitness > evals[static_cast<std::size_t>(best)].fitness) best = c;
+        }
+        return best;
+    };
+
+    for (int i = 0; i < n; ++i) {
+        float* child = spare.data() + static_cast<std::size_t>(i) * Brain::GENOME_STRIDE;
+        if (i < params.elite) {
+            std::copy(genome(rank[static_cast<std::size_t>(i)]),
+                      genome(rank[static_cast<std::size_t>(i)]) + Brain::GENOME_STRIDE, child);
+            continue;
+        }
+        const float* a = genome(pick());
+        const float* b = genome(pick());
+        for (int k = 0; k < Brain::GENOME_SIZE; ++k) {
+            float w = (rng.nextU32() & 1u) ? a[k] : b[k];
+            if (rng.uniform() < params.mutationRate) w += params.mutationSigma * rng.gaussian();
+            child[k] = w;
+        }
+    }
+    genes.swap(spare);
+    ++generation;
+}
+
+// ─── Checkpoints ──────────────────────────────────────────────────────────
+// Layout (.fbn), little-endian:
+//   "FBN" + version byte
+//   u32 inputs, hidden, stride (must match this build's Brain)
+//   u32 population, elite, tournament, episodes, tickRate, difficulty, hitbox
+//   f32 mutationRate, mutationSigma, maxSeconds
+//   u64 seed, u32 generation, f32 champion fitness
+//   stride f32 champion, population × stride f32 genomes
+static void putU32(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+static void putU64(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+}
+static void putF32(std::vector<std::uint8_t>& out, float f) {
+    std::uint32_t v;
+    std::memcpy(&v, &f, 4);
+    putU32(out, v);
+}
+
+struct CheckpointReader {
+    const std::uint8_t* p;
+    const std::uint8_t* end;
+    bool ok = true;
+
+    std::uint64_t bytes(int n) {
+        if (end - p < n) { ok = false; return 0; }
+        std::uint64_t v = 0;
+        for (int i = 0; i < n; ++i) v |= static_cast<std::uint64_t>(*p++) << (8 * i);
+        return v;
+    }
+    std::uint32_t u32() { return static_cast<std::uint32_t>(bytes(4)); }
+    std::uint64_t u64() { return bytes(8); }
+    float f32() {
+        std::uint32_t v = u32();
+        float f;
+        std::memcpy(&f, &v, 4);
+        return f;
+    }
+};
+
+bool Population::save(const std::string& path) const {
+    std::vector<std::uint8_t> out = { 'F', 'B', 'N', VERSION };
+    out.reserve(128 + (genes.size() + champion.size()) * 4);
+    putU32(out, Brain::INPUTS);
+    putU32(out, Brain::HIDDEN);
+    putU32(out, Brain::GENOME_STRIDE);
+    putU32(out, static_cast<std::uint32_t>(params.population));
+    putU32(out, static_cast<std::uint32_t>(params.elite));
+    putU32(out, static_cast<std::uint32_t>(params.tournament));
+    putU32(out, static_cast<std::uint32_t>(params.episodes));
+    putU32(out, static_cast<std::uint32_t>(params.tickRate));
+    putU32(out, static_cast<std::uint32_t>(params.difficulty));
+    putU32(out, static_cast<std::uint32_t>(params.hitbox));
+    putF32(out, params.mutationRate);
+    putF32(out, params.mutationSigma);
+    putF32(out, params.maxSeconds);
+    putU64(out, params.seed);
+    putU32(out, static_cast<std::uint32_t>(generation));
+    putF32(out, championFitness);
+    for (float f : champion) putF32(out, f);
+    for (float f : genes)    putF32(out, f);
+
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary);
+        if (!f.is_open()) return false;
+        f.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        if (!f) return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+bool Population::load(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) return false;
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(f)),
+                                     std::istreambuf_iterator<char>());
+    if (bytes.size() < 4 || bytes[0] != 'F' || bytes[1] != 'B' || bytes[2] != 'N' || bytes[3] != VERSION)
+        return false;
+    CheckpointReader r{ bytes.data() + 4, bytes.data() + bytes.size() };
+    if (r.u32() != Brain::INPUTS || r.u32() != Brain::HIDDEN || r.u32() != Brain::GENOME_STRIDE) return false;
+
+    EvolutionParams p;
+    p.population    = static_cast<int>(r.u32());
+    p.elite         = static_cast<int>(r.u32());
+    p.tournament    = static_cast<int>(r.u32());
+    p.episodes      = static_cast<int>(r.u32());
+    p.tickRate      = static_cast<int>(r.u32());
+    const std::uint32_t d = r.u32(), h = r.u32();
+    p.mutationRate  = r.f32();
+    p.mutationSigma = r.f32();
+    p.maxSeconds    = r.f32();
+    p.seed          = r.u64();
+    const std::uint32_t gen = r.u32();
+    const float bestFitness = r.f32();
+    if (!r.ok || p.population <= 0 || p.tickRate <= 0 || p.episodes <= 0 ||
+        d > static_cast<std::uint32_t>(Difficulty::HARD) || h > static_cast<std::uint32_t>(HitboxMode::HULL))
+        return false;
+    p.difficulty = static_cast<Difficulty>(d);
+    p.hitbox     = static_cast<HitboxMode>(h);
+    const std::size_t floats = static_cast<std::size_t>(p.population + 1) * Brain::GENOME_STRIDE;
+    if (static_cast<std::size_t>(r.end - r.p) != floats * 4) return false;
+
+    *this = Population(p);
+    generation      = static_cast<int>(gen);
+    championFitness = bestFitness;
+    for (float& w : champion) w = r.f32();
+    for (float& w : genes)    w = r.f32();
+    return true;
+}
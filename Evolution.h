@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Brain.h"
+#include "WorkPool.h"
+
+// ─── Neuroevolution ───────────────────────────────────────────────────────
+// A population of Brain genomes, packed back to back in one array. Each
+// generation every genome flies the same `episodes` courses through the
+// real SimWorld rules; its fitness is the mean of
+//   seconds alive + PIPE_BONUS per pipe - how far it missed the gap by
+// over those courses. The next generation keeps the `elite` best as they
+// are and breeds the rest from tournaments, with uniform crossover and
+// Gaussian mutation.
+//
+// Courses and breeding draw from seeded streams and evaluations write to
+// per-genome slots, so a run is identical on any number of threads and
+// resumes from a checkpoint exactly as if it had never stopped.
+
+struct EvolutionParams {
+    int           population    = 256;
+    int           elite         = 8;
+    int           tournament    = 4;
+    float         mutationRate  = 0.1f;    // chance each weight is perturbed
+    float         mutationSigma = 0.3f;
+    int           episodes      = 4;       // courses per genome per generation
+    float         maxSeconds    = 30.f;    // an episode that survives this long ends
+    int           tickRate      = 120;
+    Difficulty    difficulty    = Difficulty::NORMAL;
+    HitboxMode    hitbox        = HitboxMode::BOX;
+    std::uint64_t seed          = 1;
+};
+
+// Totals over one genome's episodes
+struct Evaluation {
+    float         fitness;
+    int           bestScore;
+    std::uint64_t ticks;
+};
+
+class Population {
+public:
+    static constexpr float PIPE_BONUS = 5.f;
+
+    explicit Population(const EvolutionParams& params);
+
+    // Generation 0: weights uniform in ±1
+    void randomize();
+    // Scores every genome of the current generation in parallel
+    void evaluate(WorkPool& pool);
+    // Replaces the evaluated generation with the next one
+    void breed();
+
+    // Binary checkpoint (.fbn) of the parameters, the generation counter,
+    // the current (unevaluated) genomes and the best genome evaluated so
+    // far. save() writes a temp file and renames it over `path`.
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    const EvolutionParams& getParams() const { return params; }
+    int  getGeneration() const { return generation; }
+    int  size() const { return params.population; }
+    const float* genome(int i) const { return genes.data() + static_cast<std::size_t>(i) * Brain::GENOME_STRIDE; }
+    const Evaluation& getEvaluation(int i) const { return evals[static_cast<std::size_t>(i)]; }
+    int  getBestIndex() const;   // in the evaluated generation
+    float getMeanFitness() const;
+
+    const float* getChampion() const { return champion.data(); }   // best genome ever evaluated
+    float getChampionFitness() const { return championFitness; }
+
+    // Flies one genome over one course until the bird dies or the cap
+    static Evaluation fly(const float* genome, SimWorld& world, std::uint64_t seed, float dt, std::uint32_t maxTicks);
+
+private:
+    static const std::uint8_t VERSION = 1;
+
+    EvolutionParams params;
+    int generation;
+    std::vector<float>      genes;   // population × GENOME_STRIDE
+    std::vector<float>      spare;   // breed() target
+    std::vector<Evaluation> evals;
+    std::vector<float>      champion;
+    float championFitness;
+
+    float* genome(int i) { return genes.data() + static_cast<std::size_t>(i) * Brain::GENOME_STRIDE; }
+    std::uint64_t courseSeed(int episode) const;
+};
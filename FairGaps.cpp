@@ -0,0 +1,161 @@
+#include "FairGaps.h"
+#include "Collision.h"
+#include <algorithm>
+
+// ─── Parameters ───────────────────────────────────────────────────────────
+FairGapParams FairGapParams::forLevel(Difficulty d) {
+    switch (d) {
+        case Difficulty::EASY:   return FairGapParams{ 3, 8, 12.f };
+        case Difficulty::HARD:   return FairGapParams{ 3, 8, 0.f };
+        case Difficulty::NORMAL:
+        default:                 return FairGapParams{ 3, 8, 6.f };
+    }
+}
+
+// ─── GapPlanner ───────────────────────────────────────────────────────────
+GapPlanner::GapPlanner()
+    : params(FairGapParams::forLevel(Difficulty::NORMAL)), dt(1.f / 120.f),
+      scout(600.f, 800.f),
+      committed(scout.getGroundY(), dt), trial(committed),
+      solverGround(scout.getGroundY()), solverDt(dt),
+      up(0.f), down(0.f), centres(),
+      planned(0), wanted(0), unproven(0),
+      holding(false), pendingTicks(0), pendingTries(0), pendingHalf(0.f)
+{
+}
+
+void GapPlanner::restart(const SimWorld& world, std::uint64_t seed) {
+    scout.setBounds(world.getWidth(), world.getHeight());
+    scout.setDifficulty(world.getDifficulty());
+    scout.reset();
+
+    if (world.getGroundY() != solverGround || dt != solverDt) {
+        solverGround = world.getGroundY();
+        solverDt     = dt;
+        committed    = ReachSolver(solverGround, solverDt);
+    }
+    const SimBird& bird = world.getBird();
+    const SimRect  bb   = bird.getBounds();
+    up   = bird.y - bb.top;
+    down = (bb.top + bb.height) - bird.y;
+    committed.begin(bird.y, bird.velocity);
+
+    rng.seed(seed, RNG_STREAM_GAMEPLAY);
+    planned  = 0;
+    wanted   = 0;
+    unproven = 0;
+    holding  = false;
+    pendingTicks = 0;
+}
+
+float GapPlanner::gapCentre(int index) {
+    wanted = std::max(wanted, index + 1);
+    while (planned <= index) work1();
+    if (index < planned - HISTORY)   // older than any snapshot a search keeps
+        return (scout.getGapMinY() + scout.getGapMaxY()) * 0.5f;
+    return centres[index & (HISTORY - 1)];
+}
+
+void GapPlanner::advance(int work) {
+    while (work > 0 && planned < wanted + params.window)
+        work -= work1();
+}
+
+// One unit of planning: a scout tick, or one candidate for the pending
+// pipe. Returns the solver ticks it cost.
+int GapPlanner::work1() {
+    return pendingTicks > 0 ? tryCandidate() : scoutTick();
+}
+
+// Safe band for the scout's current tick (as traceCourse builds it). Fails
+// on the first pipe over the bird that has no centre yet.
+bool GapPlanner::band(float& lo, float& hi, int& unplanned, float& half) const {
+    const PipeRing& pipes = scout.getPipes();
+    const SimRect   bb    = scout.getBird().getBounds();
+    const float     o     = SimWorld::PIPE_OUTLINE;
+    const int       first = scout.getPipesSpawned() - pipes.size();
+    lo = 0.f;
+    hi = scout.getGroundY();
+    for (int i = 0; i < pipes.size(); ++i) {
+        const SimPipe& p = pipes[i];
+        if (pipeRight(p.x) <= bb.left) continue;
+        if (pipeLeft(p.x) >= bb.left + bb.width) break;
+        const int   index = first + i;
+        const float h     = (p.botY - p.topY) * 0.5f;
+        if (index >= planned) {
+            unplanned = index;
+            half      = h;
+            return false;
+        }
+        const float c = centres[index & (HISTORY - 1)];
+        lo = std::max(lo, c - h + o + up);
+        hi = std::min(hi, c + h - o - down);
+    }
+    return true;
+}
+
+int GapPlanner::scoutTick() {
+    if (!holding) scout.stepCourse(dt);
+    holding = false;
+
+    float lo, hi, half;
+    int   index;
+    if (!band(lo, hi, index, half)) {
+        // The bird reaches a pipe with no centre: time how long it stays
+        // over it, then decide it before this tick is applied
+        SimSnapshot snap;
+        scout.save(snap);
+        const SimRect bb = scout.getBird().getBounds();
+        int ticks = 0;
+        for (;;) {
+            ++ticks;
+            scout.stepCourse(dt);
+            const PipeRing& pipes = scout.getPipes();
+            const int i = index - (scout.getPipesSpawned() - pipes.size());
+            if (i < 0 || pipeRight(pipes[i].x) <= bb.left) break;
+        }
+        scout.restore(snap);
+        holding      = true;
+        pendingTicks = ticks;
+        pendingTries = 0;
+        pendingHalf  = half;
+        return 1;
+    }
+    if (!committed.step(lo, hi)) {
+        // Only after a fallback that could not be proven: pick the proof
+        // up again from the middle of the band
+        committed.begin((lo + hi) * 0.5f);
+    }
+    return 1;
+}
+
+// Draws (or falls back to) a centre for the pending pipe and keeps it if
+// some live state survives every tick over the pipe with `margin` to spare
+int GapPlanner::tryCandidate() {
+    const float minY = scout.getGapMinY();
+    const float maxY = scout.getGroundY() - pendingHalf;   // the range at the pipe's spawn
+    float c;
+    if (pendingTries < params.tries)
+        c = rng.uniform(minY, maxY);
+    else if (planned > 0)   // then the previous centre, usually a level flight
+        c = std::min(std::max(centres[(planned - 1) & (HISTORY - 1)], minY), maxY);
+    else
+        c = (minY + maxY) * 0.5f;
+
+    const float o  = SimWorld::PIPE_OUTLINE;
+    const float lo = c - pendingHalf + o + up + params.margin;
+    const float hi = c + pendingHalf - o - down - params.margin;
+    trial = committed;
+    bool ok = true;
+    for (int t = 0; t < pendingTicks && ok; ++t) ok = trial.step(lo, hi);
+
+    const int cost = pendingTicks;
+    if (ok || pendingTries >= params.tries) {
+        if (!ok) ++unproven;
+        centres[planned & (HISTORY - 1)] = c;
+        ++planned;
+        pendingTicks = 0;
+    }
+    ++pendingTries;
+    return cost;
+}
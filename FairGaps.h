@@ -0,0 +1,77 @@
+#pragma once
+#include "SimWorld.h"
+#include "Reachability.h"
+
+// ─── Fair gap layout ──────────────────────────────────────────────────────
+// Gap centres are still drawn uniformly, but a draw is only committed once
+// ReachSolver has proven that some flap sequence gets from the pipes
+// already planned through the new one. The planner runs a pipes-only scout
+// world a few pipes ahead of the real one, so the proof uses the real
+// spawn timing, scroll speed and ramp, and each pipe costs a bounded number
+// of solver ticks no matter how long the run gets.
+//
+// The proof is the BOX band of Reachability.h; with the HULL hitbox it is
+// a close approximation. It assumes the world steps at the planner's dt.
+
+enum class GapLayout { UNIFORM, FAIR };
+
+struct FairGapParams {
+    int   window;   // pipes planned ahead of the newest spawn
+    int   tries;    // uniform draws per pipe before falling back
+    float margin;   // px the proof keeps clear of each gap edge
+
+    static FairGapParams forLevel(Difficulty d);
+};
+
+class GapPlanner : public GapSource {
+public:
+    // Centres kept for spawn indices behind the newest, so a restored
+    // snapshot still sees its own course. Must stay a power of two.
+    static constexpr int HISTORY = 64;
+    // Solver ticks per world tick that keep the window full at any speed
+    static constexpr int WORK_PER_TICK = 16;
+
+    GapPlanner();
+
+    void setParams(const FairGapParams& p) { params = p; }
+    void setStep(float stepDt) { dt = stepDt; }   // the world's fixed tick
+
+    void  restart(const SimWorld& world, std::uint64_t seed) override;
+    // Plans synchronously if the window has run dry, which only happens
+    // when advance() is never called
+    float gapCentre(int index) override;
+
+    // Spends about `work` solver ticks extending the plan. Call once per
+    // world tick so a spawn never waits on it.
+    void advance(int work);
+
+    int getPlanned() const { return planned; }
+    int getUnproven() const { return unproven; }   // pipes committed without a proof
+
+private:
+    FairGapParams params;
+    float dt;
+
+    SimWorld    scout;       // pipe timing only; its own gaps are ignored
+    ReachSolver committed;   // every state a bird can be in at the scout's tick
+    ReachSolver trial;
+    float solverGround, solverDt;
+    Rng   rng;
+    float up, down;          // bird box above and below its centre
+
+    float centres[HISTORY];
+    int   planned;    // spawn indices with a centre
+    int   wanted;     // one past the highest index asked for
+    int   unproven;
+
+    // Pipe the scout has reached but not yet decided
+    bool  holding;    // the scout's current tick is not yet applied
+    int   pendingTicks;
+    int   pendingTries;
+    float pendingHalf;
+
+    int  work1();
+    int  scoutTick();
+    int  tryCandidate();
+    bool band(float& lo, float& hi, int& unplanned, float& half) const;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+
+// ─── Fixed-point scalar ───────────────────────────────────────────────────
+// Q32.32 in a signed 64-bit integer, the deterministic arithmetic for
+// SimWorld (see SimReal in SimWorld.h). Everything is integer math, so a
+// result never depends on the compiler, its flags (-ffast-math, FMA
+// contraction, x87 excess precision) or the CPU.
+//
+// Conversion from float is exact for every value the game stores (and
+// truncates below 2^-32); conversion to float rounds once, to nearest, the
+// same way on every build. Products round to nearest, quotients truncate,
+// and both saturate. Dividing by zero gives zero, which Collision.h reads
+// as "no motion on this axis".
+
+__extension__ typedef __int128 FixedWide;
+
+struct Fixed {
+    std::int64_t raw;
+
+    static constexpr int          FRAC_BITS = 32;
+    static constexpr std::int64_t ONE       = std::int64_t(1) << FRAC_BITS;
+
+    Fixed() = default;
+    explicit Fixed(float f) : raw(fromFloat(f)) {}
+    explicit operator float() const { return static_cast<float>(raw) * (1.f / 4294967296.f); }
+
+    static Fixed fromRaw(std::int64_t r) { Fixed f; f.raw = r; return f; }
+    static Fixed lowest()  { return fromRaw(INT64_MIN); }
+    static Fixed highest() { return fromRaw(INT64_MAX); }
+
+    Fixed operator-() const { return fromRaw(-raw); }
+
+    friend Fixed operator+(Fixed a, Fixed b) { return fromRaw(a.raw + b.raw); }
+    friend Fixed operator-(Fixed a, Fixed b) { return fromRaw(a.raw - b.raw); }
+    friend Fixed operator*(Fixed a, Fixed b) {
+        const FixedWide p = static_cast<FixedWide>(a.raw) * b.raw;
+        return fromRaw(saturate((p + (ONE >> 1)) >> FRAC_BITS));
+    }
+    friend Fixed operator/(Fixed a, Fixed b) {
+        if (b.raw == 0) return fromRaw(0);
+        return fromRaw(saturate(static_cast<FixedWide>(a.raw) * ONE / b.raw));
+    }
+
+    friend bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+    friend bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+    friend bool operator< (Fixed a, Fixed b) { return a.raw <  b.raw; }
+    friend bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+    friend bool operator> (Fixed a, Fixed b) { return a.raw >  b.raw; }
+    friend bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+private:
+    // f * 2^32 only moves the exponent, so the cast sees an exact value
+    static std::int64_t fromFloat(float f) {
+        if (f >=  2147483648.f) return INT64_MAX;
+        if (f <= -2147483648.f) return INT64_MIN;
+        if (f != f) return 0;
+        return static_cast<std::int64_t>(f * 4294967296.f);
+    }
+    static std::int64_t saturate(FixedWide v) {
+        if (v > INT64_MAX) return INT64_MAX;
+        if (v < INT64_MIN) return INT64_MIN;
+        return static_cast<std::int64_t>(v);
+    }
+};
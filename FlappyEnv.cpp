@@ -0,0 +1,157 @@
+#include "flappy_env.h"
+#include "FairGaps.h"
+#include "SimWorld.h"
+#include <memory>
+#include <new>
+#include <vector>
+
+// ─── C ABI over SimWorld ──────────────────────────────────────────────────
+// Every buffer a step touches is sized in flappy_create(); the calls
+// below only index into it.
+
+struct EnvSlot {
+    SimWorld      world;
+    std::unique_ptr<GapPlanner> planner;   // fair gaps only
+    std::uint64_t seed;       // of the current episode
+    std::uint64_t episode;    // episodes since flappy_reset (batch seeding)
+    std::uint8_t  done;
+
+    EnvSlot() : world(600.f, 800.f), seed(0), episode(0), done(FLAPPY_DONE_NO) {}
+};
+
+struct flappy_env {
+    flappy_config cfg;
+    float dt;
+    std::vector<EnvSlot> slots;
+};
+
+static void restart(EnvSlot& s, std::uint64_t seed) {
+    s.seed = seed;
+    s.done = FLAPPY_DONE_NO;
+    s.world.reset(seed);
+}
+
+static_assert(static_cast<int>(FLAPPY_OBS_SIZE) == static_cast<int>(SIM_OBS_SIZE) &&
+              static_cast<int>(FLAPPY_OBS_PIPE_BOT) == static_cast<int>(SIM_OBS_PIPE_BOT),
+              "flappy_env.h observations must match SimWorld::observe");
+
+static void observeSlot(const EnvSlot& s, float* o) { s.world.observe(o); }
+
+// One tick of one world; returns its reward and sets s.done
+static float stepSlot(EnvSlot& s, const flappy_config& cfg, float dt, bool flap) {
+    if (s.done != FLAPPY_DONE_NO) return 0.f;
+    if (s.planner) s.planner->advance(GapPlanner::WORK_PER_TICK);
+    const int before = s.world.getScore();
+    if (flap) s.world.flap();
+    const unsigned events = s.world.step(dt);
+    float reward = static_cast<float>(s.world.getScore() - before);
+    if ((events & SIM_DIED) || s.world.isOver()) {
+        reward -= 1.f;
+        s.done = FLAPPY_DONE_DIED;
+    } else if (cfg.max_ticks > 0 && s.world.getTick() >= static_cast<std::uint32_t>(cfg.max_ticks)) {
+        s.done = FLAPPY_DONE_TRUNCATED;
+    }
+    return reward;
+}
+
+extern "C" {
+
+uint32_t flappy_abi_version(void) { return FLAPPY_ABI_VERSION; }
+
+void flappy_default_config(flappy_config* cfg) {
+    if (!cfg) return;
+    cfg->num_envs   = 1;
+    cfg->difficulty = static_cast<int32_t>(Difficulty::NORMAL);
+    cfg->hitbox     = static_cast<int32_t>(HitboxMode::BOX);
+    cfg->gaps       = static_cast<int32_t>(GapLayout::UNIFORM);
+    cfg->tick_rate  = 120;
+    cfg->max_ticks  = 0;
+    cfg->seed       = 1;
+}
+
+flappy_env* flappy_create(const flappy_config* cfg) {
+    if (!cfg || cfg->num_envs < 1 || cfg->tick_rate < 1 || cfg->max_ticks < 0 ||
+        cfg->difficulty < 0 || cfg->difficulty > static_cast<int32_t>(Difficulty::HARD) ||
+        cfg->hitbox < 0 || cfg->hitbox > static_cast<int32_t>(HitboxMode::HULL) ||
+        cfg->gaps < 0 || cfg->gaps > static_cast<int32_t>(GapLayout::FAIR))
+        return nullptr;
+    try {
+        std::unique_ptr<flappy_env> env(new flappy_env);
+        env->cfg = *cfg;
+        env->dt  = 1.f / static_cast<float>(cfg->tick_rate);
+        env->slots.resize(static_cast<std::size_t>(cfg->num_envs));
+
+        const Difficulty level = static_cast<Difficulty>(cfg->difficulty);
+        for (EnvSlot& s : env->slots) {
+            s.world.setDifficulty(DifficultyParams::forLevel(level));
+            s.world.setHitboxMode(static_cast<HitboxMode>(cfg->hitbox));
+            if (cfg->gaps == static_cast<int32_t>(GapLayout::FAIR)) {
+                s.planner.reset(new GapPlanner());
+                s.planner->setParams(FairGapParams::forLevel(level));
+                s.planner->setStep(env->dt);
+                s.world.setGapSource(s.planner.get());
+            }
+        }
+        flappy_reset(env.get(), cfg->seed, nullptr);
+        return env.release();
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void flappy_destroy(flappy_env* env) { delete env; }
+
+int32_t flappy_num_envs(const flappy_env* env) { return env ? env->cfg.num_envs : 0; }
+
+void flappy_reset(flappy_env* env, uint64_t seed, float* obs) {
+    if (!env) return;
+    env->cfg.seed = seed;
+    for (std::size_t i = 0; i < env->slots.size(); ++i) {
+        EnvSlot& s = env->slots[i];
+        s.episode = 0;
+        restart(s, seed + i);
+        if (obs) observeSlot(s, obs + i * FLAPPY_OBS_SIZE);
+    }
+}
+
+void flappy_reset_env(flappy_env* env, int32_t index, uint64_t seed, float* obs) {
+    if (!env || index < 0 || index >= env->cfg.num_envs) return;
+    EnvSlot& s = env->slots[static_cast<std::size_t>(index)];
+    restart(s, seed);
+    if (obs) observeSlot(s, obs);
+}
+
+void flappy_step(flappy_env* env, int32_t index, int32_t action, float* obs, float* reward, uint8_t* done) {
+    if (!env || index < 0 || index >= env->cfg.num_envs) return;
+    EnvSlot& s = env->slots[static_cast<std::size_t>(index)];
+    const float r = stepSlot(s, env->cfg, env->dt, action != 0);
+    if (obs)    observeSlot(s, obs);
+    if (reward) *reward = r;
+    if (done)   *done = s.done;
+}
+
+void flappy_step_batch(flappy_env* env, const uint8_t* actions, float* obs, float* rewards,
+                       uint8_t* dones, int32_t* scores) {
+    if (!env) return;
+    const std::uint64_t n = env->slots.size();
+    for (std::size_t i = 0; i < env->slots.size(); ++i) {
+        EnvSlot& s = env->slots[i];
+        const float r = stepSlot(s, env->cfg, env->dt, actions && actions[i] != 0);
+        if (rewards) rewards[i] = r;
+        if (dones)   dones[i]   = s.done;
+        if (scores)  scores[i]  = s.world.getScore();
+        if (s.done != FLAPPY_DONE_NO) {
+            ++s.episode;
+            restart(s, env->cfg.seed + i + s.episode * n);
+        }
+        if (obs) observeSlot(s, obs + i * FLAPPY_OBS_SIZE);
+    }
+}
+
+void flappy_observe(const flappy_env* env, float* obs) {
+    if (!env || !obs) return;
+    for (std::size_t i = 0; i < env->slots.size(); ++i)
+        observeSlot(env->slots[i], obs + i * FLAPPY_OBS_SIZE);
+}
+
+}
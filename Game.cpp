@@ -1,8 +1,9 @@
 #include "Game.h"
+#include "Log.h"
 #include <fstream>
-#include <cmath>
-#include <cstdlib>
+#include <filesystem>
 #include <ctime>
+#include <cmath>
 #include <algorithm>
 
 const float PI = 3.14159265f;
@@ -26,19 +27,22 @@ static sf::SoundBuffer makeTone(float freq, float dur, float vol = 1.f,
 
 // ─── Constructor ──────────────────────────────────────────────────────────
 // Initializer list order MUST match member declaration order in Game.h
-Game::Game()
+Game::Game(std::uint64_t seed)
     : windowWidth(BASE_WIDTH), windowHeight(BASE_HEIGHT),
       scaleFactor(1.0f),
       platform(PlatformMode::DESKTOP),
       window(sf::VideoMode(BASE_WIDTH, BASE_HEIGHT),
              "Flappy Bird",
              sf::Style::Titlebar | sf::Style::Close),
-      bird(BASE_WIDTH * 0.25f, BASE_HEIGHT * 0.4f),
+      seed(seed), runIndex(0), runSeed(seed),
+      cosmeticRng(seed, RNG_STREAM_COSMETIC),
+      world(static_cast<float>(BASE_WIDTH), static_cast<float>(BASE_HEIGHT), seed),
+      bird(SimWorld::BIRD_START_X, SimWorld::BIRD_START_Y),
       state(GameState::MENU),
       difficulty(Difficulty::NORMAL),
-      pipeSpawnTimer(0.f),
-      pipeSpawnInterval(2.4f),
-      score(0), highScore(0), selectedDifficulty(1),
+      hitboxMode(HitboxMode::BOX),
+      gapLayout(GapLayout::UNIFORM),
+      highScore(0), selectedDifficulty(1),
       flashAlpha(0.f),
       soundEnabled(true),
       currentScenario(SkyScenario::MORNING),
@@ -46,22 +50,32 @@ Game::Game()
       blendT(0.f), isBlending(false),
       scenarioLabelTimer(0.f),
       cloudSpawnTimer(0.f),
+      starCount(400),
       bgBirdSpawnTimer(0.f),
       groundSpeed(160.f),
-      rippleAlpha(0.f)
+      backgroundFrames(0), skyBakes(0),
+      playingFrames(0), pipeDrawCalls(0), pipeShapeDrawCalls(0),
+      rippleAlpha(0.f),
+      fixedStep(true), tickRate(120),
+      accumulator(0.f), lastStepDt(0.f), renderAlpha(1.f),
+      prevBird(SimWorld::BIRD_START_X, SimWorld::BIRD_START_Y),
+      recordingRun(false),
+      attractMode(true), attractRunning(false)
 {
     window.setFramerateLimit(60);
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
     detectPlatform();
     updateScaling();
     buildFonts();
     buildSounds();
     buildSkySystem();
+    buildSkyShader();
     buildClouds();
     buildStars();
     buildMountains();
+    buildBackgroundCache();
     buildGround();
     buildUI();
+    buildBirdAtlas();
     loadHighScore();
     setDifficulty(Difficulty::NORMAL);
 }
@@ -174,37 +188,79 @@ void Game::buildSounds() {
 // ─── Difficulty ───────────────────────────────────────────────────────────
 void Game::setDifficulty(Difficulty d) {
     difficulty = d;
-    switch (d) {
-        case Difficulty::EASY:
-            Pipe::SPEED = 120.f; Pipe::GAP = 220.f; pipeSpawnInterval = 3.0f; break;
-        case Difficulty::NORMAL:
-            Pipe::SPEED = 160.f; Pipe::GAP = 185.f; pipeSpawnInterval = 2.4f; break;
-        case Difficulty::HARD:
-            Pipe::SPEED = 210.f; Pipe::GAP = 145.f; pipeSpawnInterval = 2.0f; break;
-    }
-    groundSpeed = Pipe::SPEED;
+    world.setDifficulty(DifficultyParams::forLevel(d));
+    groundSpeed = world.getPipeSpeed();
 }
 
 // ─── Game Reset ───────────────────────────────────────────────────────────
 void Game::resetGame() {
-    bird.reset(BASE_WIDTH * 0.25f, BASE_HEIGHT * 0.4f);
-    pipes.clear();
-    pipeSpawnTimer = 0.f;
-    score          = 0;
+    if (player.isActive()) {
+        // Playback: the replay dictates seed, difficulty and tick rate
+        runSeed    = loadedReplay.seed;
+        difficulty = loadedReplay.difficulty;
+        tickRate   = static_cast<int>(loadedReplay.tickRate);
+        fixedStep  = true;
+        player.start(loadedReplay);
+        world.setBounds(static_cast<float>(loadedReplay.width), static_cast<float>(loadedReplay.height));
+    } else {
+        runSeed    = seed + runIndex++;
+        world.setBounds(static_cast<float>(windowWidth), static_cast<float>(windowHeight));
+    }
+    world.setHitboxMode(player.isActive() ? loadedReplay.hitbox : hitboxMode);
+    // Before the reset: the fair planner scouts with the world's difficulty
+    setDifficulty(difficulty);
+    const GapLayout layout = player.isActive() ? loadedReplay.layout : gapLayout;
+    planner.setParams(FairGapParams::forLevel(difficulty));
+    planner.setStep(1.f / static_cast<float>(tickRate));
+    world.setGapSource(layout == GapLayout::FAIR ? &planner : nullptr);
+    world.reset(runSeed);
+    attractRunning = false;
+    prevBird       = world.getBird();
     flashAlpha     = 0.f;
     scenarioTimer  = 0.f;
     // Advance to next scenario each restart — cycles through all 8
     advanceScenario();
-    setDifficulty(difficulty);
+
+    // Flap ticks only mean something when the world advances in fixed steps
+    recordingRun = !recordDir.empty() && fixedStep && !player.isActive() &&
+                   Replay::validBounds(difficulty, static_cast<std::uint64_t>(windowWidth),
+                                       static_cast<std::uint64_t>(windowHeight));
+    if (recordingRun)
+        recording.begin(runSeed, difficulty, hitboxMode, gapLayout, static_cast<std::uint32_t>(tickRate),
+                        static_cast<std::uint32_t>(windowWidth),
+                        static_cast<std::uint32_t>(windowHeight));
 }
 
-// ─── Pipe Spawning ────────────────────────────────────────────────────────
-void Game::spawnPipe() {
-    float minY = 140.f;
-    float maxY = static_cast<float>(windowHeight) - 80.f - Pipe::GAP * 0.5f;
-    float gapY = minY + (static_cast<float>(std::rand()) / RAND_MAX) * (maxY - minY);
-    pipes.emplace_back(static_cast<float>(windowWidth + 20), gapY,
-                       static_cast<float>(windowHeight - 80));
+// ─── Replays ──────────────────────────────────────────────────────────────
+void Game::setRecordDir(const std::string& dir) {
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    recordDir = dir;
+}
+
+bool Game::loadReplay(const std::string& path) {
+    if (!loadedReplay.load(path)) return false;
+    player.start(loadedReplay);
+    resetGame();
+    state = GameState::PLAYING;
+    return true;
+}
+
+void Game::finishRecording() {
+    if (!recordingRun) return;
+    recordingRun        = false;
+    recording.tickCount = world.getTick();
+    recording.score     = static_cast<std::uint32_t>(world.getScore());
+    recording.save(recordDir + "/run_" + std::to_string(std::time(nullptr)) +
+                   "_" + std::to_string(runSeed) + ".fbr");
+}
+
+// Player input: ignored while a replay drives the bird
+void Game::flapBird() {
+    if (player.isActive() || world.getBird().isDead()) return;
+    world.flap();
+    if (recordingRun) recording.addFlap(world.getTick());
+    if (soundEnabled) flapSnd.play();
 }
 
 // ─── High Score IO ────────────────────────────────────────────────────────
@@ -230,9 +286,8 @@ void Game::processEvents() {
                 soundButton.label.setString(soundEnabled ? "ON" : "OFF");
                 continue;
             }
-            if (state == GameState::PLAYING && !bird.isDead()) {
-                bird.flap();
-                if (soundEnabled) flapSnd.play();
+            if (state == GameState::PLAYING) {
+                flapBird();
             } else if (state == GameState::GAMEOVER) {
                 resetGame();
                 state = GameState::PLAYING;
@@ -254,21 +309,18 @@ void Game::processEvents() {
                     if (soundEnabled) swooshSnd.play();
                 }
             } else if (state == GameState::PLAYING) {
-                if (key == sf::Keyboard::Space && !bird.isDead()) {
-                    bird.flap();
-                    if (soundEnabled) flapSnd.play();
-                }
+                if (key == sf::Keyboard::Space) flapBird();
                 if (key == sf::Keyboard::Escape) state = GameState::PAUSED;
             } else if (state == GameState::PAUSED) {
                 if (key == sf::Keyboard::Escape) state = GameState::PLAYING;
-                if (key == sf::Keyboard::M)      state = GameState::MENU;
+                if (key == sf::Keyboard::M)      { player.stop(); state = GameState::MENU; }
             } else if (state == GameState::GAMEOVER) {
                 if (key == sf::Keyboard::Space) {
                     resetGame();
                     state = GameState::PLAYING;
                     if (soundEnabled) swooshSnd.play();
                 }
-                if (key == sf::Keyboard::M) state = GameState::MENU;
+                if (key == sf::Keyboard::M) { player.stop(); state = GameState::MENU; }
             }
         }
     }
@@ -277,14 +329,25 @@ void Game::processEvents() {
 void Game::handleResize() {
     windowWidth  = window.getSize().x;
     windowHeight = window.getSize().y;
+    // A replay pins the bounds it was recorded with; a live recording that
+    // changes bounds mid-run can no longer be re-simulated, so drop it
+    if (!player.isActive()) {
+        if (recordingRun && (static_cast<std::uint32_t>(windowWidth)  != recording.width ||
+                             static_cast<std::uint32_t>(windowHeight) != recording.height))
+            recordingRun = false;
+        world.setBounds(static_cast<float>(windowWidth), static_cast<float>(windowHeight));
+    }
     updateScaling();
+    layoutSkyQuad();
+    buildBackgroundCache();
     window.setView(sf::View(sf::FloatRect(0, 0,
         static_cast<float>(windowWidth),
         static_cast<float>(windowHeight))));
 }
 
 // ─── Update ───────────────────────────────────────────────────────────────
-void Game::update(float dt) {
+// Cosmetic layers advance once per rendered frame
+void Game::updateScenery(float dt) {
     updateSky(dt);
     updateClouds(dt);
     updateStars(dt);
@@ -294,76 +357,117 @@ void Game::update(float dt) {
     if (rippleAlpha > 0.f) { rippleAlpha -= 200.f*dt; if (rippleAlpha<0.f) rippleAlpha=0.f; }
     if (flashAlpha  > 0.f) { flashAlpha  -= 400.f*dt; if (flashAlpha <0.f) flashAlpha =0.f; }
     if (scenarioLabelTimer > 0.f) scenarioLabelTimer -= dt;
+}
 
+// Gameplay advances once per simulation tick
+void Game::update(float dt) {
+    prevBird     = world.getBird();
+    prevGroundX[0] = groundX[0];
+    prevGroundX[1] = groundX[1];
+    lastStepDt   = dt;
+
+    if (agent.isListening())          { updateAgent(); return; }
     if (state == GameState::MENU)     updateMenu(dt);
     if (state == GameState::PLAYING)  updatePlaying(dt);
     if (state == GameState::GAMEOVER) updateGameOver(dt);
 }
 
 void Game::updateMenu(float dt) {
-    bird.update(dt * 0.f);
-    bird.animateWing(dt);
+    if (!attractMode) {
+        world.idle(dt);
+        for (int i = 0; i < 2; ++i) {
+            groundX[i] -= groundSpeed * 0.5f * dt;
+            if (groundX[i] <= -windowWidth) groundX[i] += windowWidth * 2.f;
+        }
+        return;
+    }
+
+    // Attract mode: a real run on the selected difficulty, no score kept
+    if (!attractRunning || world.isOver()) startAttractRun();
+    if (world.getGapSource() == &planner) planner.advance(GapPlanner::WORK_PER_TICK);
+    if (autopilot.decide(world, dt)) world.flap();
+    world.step(dt);
+    groundSpeed = world.getPipeSpeed();
     for (int i = 0; i < 2; ++i) {
-        groundX[i] -= groundSpeed * 0.5f * dt;
+        groundX[i] -= groundSpeed * dt;
         if (groundX[i] <= -windowWidth) groundX[i] += windowWidth * 2.f;
     }
 }
 
+// ─── Agent control ───────────────────────────────────────────────────────
+bool Game::serveAgent(unsigned short port) {
+    if (!agent.listen(port)) return false;
+    attractMode = false;
+    return true;
+}
+
+// At most one world tick per game tick, none while paused; resets and
+// observations are free. Before the first reset the menu idles as usual,
+// and after a death the bird falls until the agent resets.
+void Game::updateAgent() {
+    agent.poll(*this, state == GameState::PAUSED ? 0 : 1);
+    if (state == GameState::MENU)     updateMenu(lastStepDt);
+    if (state == GameState::GAMEOVER) updateGameOver(lastStepDt);
+}
+
+void Game::agentReset(std::uint64_t s) {
+    seed     = s;
+    runIndex = 0;
+    resetGame();
+    state = GameState::PLAYING;
+}
+
+void Game::agentStep(bool flap) {
+    if (state != GameState::PLAYING) return;
+    if (flap) flapBird();
+    updatePlaying(lastStepDt);
+}
+
+// Attract runs take their seeds from the cosmetic stream, so they never
+// shift the session's course seeds
+
+void Game::startAttractRun() {
+    world.setBounds(static_cast<float>(windowWidth), static_cast<float>(windowHeight));
+    world.setDifficulty(DifficultyParams::forLevel(static_cast<Difficulty>(selectedDifficulty)));
+    world.setHitboxMode(hitboxMode);
+    planner.setParams(FairGapParams::forLevel(static_cast<Difficulty>(selectedDifficulty)));
+    planner.setStep(1.f / static_cast<float>(tickRate));
+    world.setGapSource(gapLayout == GapLayout::FAIR ? &planner : nullptr);
+    world.reset(cosmeticRng.nextU32());
+    prevBird       = world.getBird();
+    attractRunning = true;
+}
+
 void Game::updatePlaying(float dt) {
-    bird.update(dt);
+    if (player.apply(world) && soundEnabled) flapSnd.play();
+    // Fair gaps: plan a little every tick so no spawn has to wait for it
+    if (world.getGapSource() == &planner) planner.advance(GapPlanner::WORK_PER_TICK);
+    // Replays step with the physics they were recorded with
+    unsigned events = world.step(dt, player.isActive() ? loadedReplay.physics : SIM_PHYSICS);
+    groundSpeed = world.getPipeSpeed();
 
     for (int i = 0; i < 2; ++i) {
         groundX[i] -= groundSpeed * dt;
         if (groundX[i] <= -windowWidth) groundX[i] += windowWidth * 2.f;
     }
 
-    pipeSpawnTimer += dt;
-    if (pipeSpawnTimer >= pipeSpawnInterval) {
-        pipeSpawnTimer = 0.f;
-        spawnPipe();
-    }
-
-    for (auto& p : pipes) {
-        p.update(dt);
-        if (p.hasPassed(bird.getX())) {
-            p.markPassed();
-            score++;
-            if (score > highScore) highScore = score;
-            if (soundEnabled) scoreSnd.play();
-
-            if (score % 10 == 0) {
-                Pipe::SPEED       = std::min(Pipe::SPEED + 5.f, 320.f);
-                groundSpeed       = Pipe::SPEED;
-                Pipe::GAP         = std::max(Pipe::GAP   - 3.f, 110.f);
-                pipeSpawnInterval = std::max(pipeSpawnInterval - 0.05f, 1.5f);
-            }
-            // celebrate is now visual-only — does NOT block input
-            if (score % 5 == 0) bird.celebrate();
-        }
+    if (events & SIM_SCORED) {
+        if (world.getScore() > highScore) highScore = world.getScore();
+        if (soundEnabled) scoreSnd.play();
     }
-
-    pipes.erase(std::remove_if(pipes.begin(), pipes.end(),
-        [](const Pipe& p){ return p.isOffScreen(); }), pipes.end());
-
-    sf::FloatRect bb = bird.getBounds();
-    for (auto& p : pipes) {
-        if (p.checkCollision(bb) && !bird.isDead()) {
-            bird.die(); if (soundEnabled) dieSnd.play(); flashAlpha = 255.f;
-        }
-    }
-    if (bird.getY() < 0.f && !bird.isDead()) {
-        bird.die(); if (soundEnabled) dieSnd.play(); flashAlpha = 255.f;
+    if (events & SIM_DIED) {
+        if (soundEnabled) dieSnd.play();
+        flashAlpha = 255.f;
     }
-    float groundY = static_cast<float>(windowHeight) - 80.f;
-    if (bird.getY() >= groundY) {
-        if (!bird.isDead()) { bird.die(); if (soundEnabled) dieSnd.play(); flashAlpha = 255.f; }
+    if (events & SIM_GROUNDED) {
         state = GameState::GAMEOVER;
+        finishRecording();
         saveHighScore();
     }
 }
 
 void Game::updateGameOver(float dt) {
-    bird.update(dt);
+    world.getBird().update(dt);
     for (int i = 0; i < 2; ++i) {
         groundX[i] -= groundSpeed * 0.3f * dt;
         if (groundX[i] <= -windowWidth) groundX[i] += windowWidth * 2.f;
@@ -417,6 +521,8 @@ void Game::advanceScenario() {
     fromTop = sky.top; fromMid = sky.mid; fromBot = sky.bottom;
     getScenarioColors(currentScenario, toTop, toMid, toBot);
     isBlending         = true;
+    skyLayerDirty      = true;
+    mountainsDirty     = true;
     blendT             = 0.f;
     scenarioTimer      = 0.f;
     scenarioLabelTimer = 2.5f;
@@ -428,12 +534,15 @@ void Game::updateSky(float dt) {
         if (scenarioTimer >= scenarioDuration) advanceScenario();
     }
 
+    // The shader cross-fades from the palettes directly; the CPU gradient
+    // needs the blended colours and a re-baked sky layer
     if (isBlending) {
+        if (!skyShaderReady) skyLayerDirty = true;
         blendT += dt / 3.0f;
         if (blendT >= 1.f) {
             blendT = 1.f; isBlending = false;
             sky.top = toTop; sky.mid = toMid; sky.bottom = toBot;
-        } else {
+        } else if (!skyShaderReady) {
             sky.top    = lerpColor(fromTop, toTop, blendT);
             sky.mid    = lerpColor(fromMid, toMid, blendT);
             sky.bottom = lerpColor(fromBot, toBot, blendT);
@@ -453,14 +562,14 @@ void Game::updateClouds(float dt) {
 }
 
 void Game::updateStars(float dt) {
-    for (auto& s : stars) s.twinklePhase += s.twinkleSpeed * dt;
+    starField.update(dt);
 }
 
 void Game::updateMountains(float dt) {
     for (int layer = 0; layer < 2; ++layer)
         for (auto& m : mountains[layer]) {
             m.baseX -= m.speed * dt;
-            if (m.baseX < -300.f) m.baseX += 1760.f;
+            if (m.baseX < -300.f) m.baseX += MOUNTAIN_WRAP;
             m.shape.setPosition(m.baseX, static_cast<float>(windowHeight) - 80.f);
         }
 }
@@ -474,13 +583,59 @@ void Game::updateBackgroundBirds(float dt) {
 }
 
 // ─── Run ──────────────────────────────────────────────────────────────────
+void Game::setSkyShader(bool enabled) {
+    skyShaderReady = enabled && sf::Shader::isAvailable() && skyShader.getNativeHandle() != 0;
+    skyLayerDirty  = true;
+}
+
+void Game::setStarCount(int count) {
+    starCount = std::max(count, SPARSE_STARS);
+    buildStars();
+}
+
+void Game::setTickRate(int hz) {
+    if (hz > 0) tickRate = hz;
+}
+
+// Fixed-step mode decouples simulation from the display: the world always
+// advances in 1/tickRate steps and render() interpolates between the last
+// two ticks using renderAlpha. Variable mode is the legacy clamped-dt loop.
 void Game::run() {
     sf::Clock clock;
     while (window.isOpen()) {
-        float dt = std::min(clock.restart().asSeconds(), 0.05f);
+        float frameDt = clock.restart().asSeconds();
         processEvents();
-        update(dt);
+
+        if (fixedStep) {
+            const float tickDt = 1.f / static_cast<float>(tickRate);
+            updateScenery(std::min(frameDt, 0.05f));
+            // Cap the backlog so a long hitch does not trigger a catch-up spiral
+            accumulator += std::min(frameDt, 0.25f);
+            while (accumulator >= tickDt) {
+                update(tickDt);
+                accumulator -= tickDt;
+            }
+            renderAlpha = accumulator / tickDt;
+        } else {
+            float dt = std::min(frameDt, 0.05f);
+            updateScenery(dt);
+            update(dt);
+            renderAlpha = 1.f;
+        }
         render();
     }
     saveHighScore();
-}
\ No newline at end of file
+
+    const LatencyStats& lat = autopilot.getLatency();
+    if (lat.getCount() > 0)
+        logLine("autopilot: %llu decisions, us p50 %.1f  p99 %.1f  p99.9 %.1f  max %.1f",
+                    static_cast<unsigned long long>(lat.getCount()), lat.percentile(0.5f),
+                    lat.percentile(0.99f), lat.percentile(0.999f), lat.getMax());
+    if (playingFrames > 0)
+        logLine("pipes: %.2f draw calls per playing frame (%.1f as separate shapes)",
+                    static_cast<double>(pipeDrawCalls) / static_cast<double>(playingFrames),
+                    static_cast<double>(pipeShapeDrawCalls) / static_cast<double>(playingFrames));
+    if (backgroundCached && backgroundFrames > 0)
+        logLine("background: sky layer re-baked on %.1f%% of frames",
+                    100.0 * static_cast<double>(skyBakes) / static_cast<double>(backgroundFrames));
+}
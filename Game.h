@@ -3,11 +3,17 @@
 #include <SFML/Audio.hpp>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include "Rng.h"
 #include "Bird.h"
+#include "BirdAtlas.h"
 #include "Pipe.h"
+#include "StarField.h"
+#include "Replay.h"
+#include "Autopilot.h"
+#include "AgentServer.h"
 
 enum class GameState   { MENU, PLAYING, PAUSED, GAMEOVER };
-enum class Difficulty  { EASY, NORMAL, HARD };
 enum class PlatformMode{ DESKTOP, MOBILE };
 
 // Sky scenarios that cycle during gameplay
@@ -23,11 +29,45 @@ enum class SkyScenario {
     COUNT
 };
 
-class Game {
+class Game : private AgentHost {
 public:
-    Game();
+    // Run k of a session plays the course generated from seed + k
+    explicit Game(std::uint64_t seed);
     void run();
 
+    // Simulation stepping: fixed ticks at tickRate Hz (default 120) with
+    // render interpolation, or the legacy variable-dt loop
+    void setTickRate(int hz);
+    void setFixedStep(bool enabled) { fixedStep = enabled; }
+
+    // Pipe collision against the old box (BOX, default) or the drawn bird
+    void setHitboxMode(HitboxMode mode) { hitboxMode = mode; }
+
+    // Uniform gap draws, or only gaps proven reachable (see FairGaps.h)
+    void setGapLayout(GapLayout layout) { gapLayout = layout; }
+
+    // Menu background: the autopilot plays real runs (on by default)
+    void setAttractMode(bool enabled) { attractMode = enabled; }
+
+    // Sky gradient, scenario cross-fade and time-of-day tint in a fragment
+    // shader (default, when supported), or the CPU vertex gradient
+    void setSkyShader(bool enabled);
+
+    // Stars in the BLACK_NIGHT sky (default 400); all of them are one draw
+    void setStarCount(int count);
+
+    // Bird drawn as one quad from the startup atlas (default, when the GPU
+    // can hold it) or from its vector shapes
+    void setBirdSprites(bool enabled) { bird.setAtlas(enabled && birdAtlas.isReady() ? &birdAtlas : nullptr); }
+
+    // An agent process drives the bird over AgentProtocol (see AgentServer.h),
+    // one tick per game tick so it can be watched. False if the port is taken.
+    bool serveAgent(unsigned short port);
+
+    // Replays: archive each finished run into dir / drive the bird from a file
+    void setRecordDir(const std::string& dir);
+    bool loadReplay(const std::string& path);
+
 private:
     // ── Order here MUST match the constructor initializer list ────────────
 
@@ -37,20 +77,28 @@ private:
     PlatformMode platform;
     sf::RenderWindow window;
 
+    // Seeding: gameplay draws from the world's own stream, scenery from cosmeticRng
+    std::uint64_t seed;
+    std::uint64_t runIndex;
+    std::uint64_t runSeed;
+    Rng           cosmeticRng;
+
     static const int BASE_WIDTH  = 600;
     static const int BASE_HEIGHT = 800;
 
-    // Game objects
+    // Game objects: world owns the rules, bird/pipeBatch only present it
+    SimWorld world;
+    GapPlanner planner;
     Bird bird;
+    BirdAtlas birdAtlas;
 
     // State
     GameState  state;
     Difficulty difficulty;
+    HitboxMode hitboxMode;
+    GapLayout  gapLayout;
 
-    // Timers / counters
-    float pipeSpawnTimer;
-    float pipeSpawnInterval;
-    int   score;
+    // Counters
     int   highScore;
     int   selectedDifficulty;
 
@@ -67,7 +115,9 @@ private:
         float transitionSpeed;
     };
     SkyGradient sky;
-    sf::VertexArray skyVertices;
+    sf::VertexArray skyVertices;   // full-screen quad, uv 0..1, for the sky shader
+    sf::Shader      skyShader;
+    bool            skyShaderReady;   // loaded and enabled; else the CPU gradient
 
     SkyScenario currentScenario;
     float       scenarioTimer;
@@ -94,13 +144,11 @@ private:
     sf::CircleShape bigMoon;
     sf::CircleShape bigMoonGlow;
 
-    // Stars
-    struct Star {
-        sf::CircleShape shape;
-        float twinklePhase;
-        float twinkleSpeed;
-    };
-    std::vector<Star> stars;
+    // Stars: BLACK_NIGHT shows the whole field, other night skies the
+    // first SPARSE_STARS at 60% brightness
+    static const int SPARSE_STARS = 40;
+    StarField starField;
+    int       starCount;
 
     // Background birds
     struct BackgroundBird {
@@ -122,14 +170,30 @@ private:
         float baseX, speed;
     };
     std::vector<Mountain> mountains[2];
+    static constexpr float MOUNTAIN_WRAP = 1760.f;   // both ranges repeat every this many px
+
+    // Background cache: sky gradient and big moon baked into one
+    // window-sized layer, re-baked only when the sky changes; each mountain
+    // range baked once into a repeating strip scrolled by texture offset
+    static constexpr int MOUNTAIN_STRIP_H = 256;
+    sf::RenderTexture skyLayer;
+    sf::RenderTexture mountainStrip[2];
+    float mountainBakeX[2];   // first mountain's baseX when its strip was baked
+    bool  backgroundCached;   // false: no render textures, layers draw live
+    bool  skyLayerDirty, mountainsDirty;
+    std::uint64_t backgroundFrames, skyBakes;
 
     // Fonts & texts
     sf::Font fontMain, fontScore;
     sf::Text scoreText, hiScoreText, titleText, instructText;
     sf::Text diffText[3], pauseText, gameoverText, restartText;
 
-    // Pipes
-    std::vector<Pipe> pipes;
+    // Pipes: one batched draw per frame. The counters compare it with the
+    // eight draws per pipe of separate outlined shapes (printed on exit).
+    PipeBatch     pipeBatch;
+    std::uint64_t playingFrames;
+    std::uint64_t pipeDrawCalls;
+    std::uint64_t pipeShapeDrawCalls;
 
     // Touch / ripple
     sf::CircleShape touchRipple;
@@ -150,15 +214,42 @@ private:
     Button soundButton;
     Button menuButtons[3];
 
+    // Fixed-step timing + render interpolation
+    bool    fixedStep;
+    int     tickRate;
+    float   accumulator;
+    float   lastStepDt;
+    float   renderAlpha;
+    SimBird prevBird;
+    float   prevGroundX[2];
+
+    // Input replay
+    std::string  recordDir;
+    bool         recordingRun;
+    Replay       recording;
+    Replay       loadedReplay;
+    ReplayPlayer player;
+
+    // Attract mode: the menu's world is played by the autopilot
+    bool         attractMode;
+    bool         attractRunning;
+    Autopilot    autopilot;
+
+    // Agent control: requests are answered between ticks
+    AgentServer  agent;
+
     // ── Methods ───────────────────────────────────────────────────────────
     void processEvents();
     void update(float dt);
+    void updateScenery(float dt);
     void render();
     void handleResize();
     void updateScaling();
 
     void updateMenu(float dt);
+    void startAttractRun();
     void updatePlaying(float dt);
+    void updateAgent();
     void updateGameOver(float dt);
     void updateSky(float dt);
     void updateClouds(float dt);
@@ -172,10 +263,16 @@ private:
     sf::Color lerpColor(sf::Color a, sf::Color b, float t);
     bool scenarioHasStars(SkyScenario s);
 
-    void renderSky();
+    float lerpTick(float prev, float cur) const;
+    void renderBackground();
+    void renderSky(sf::RenderTarget& target);
+    void renderBigMoon(sf::RenderTarget& target);
     void renderCelestial();
-    void renderStars();
+    void renderStars(sf::RenderTarget& target);
     void renderMountains();
+    sf::Color mountainColor(int layer);
+    void bakeSkyLayer();
+    void bakeMountains();
     void renderClouds();
     void renderBackgroundBirds();
     void renderGround();
@@ -186,19 +283,28 @@ private:
     void renderTouchIndicator();
     void renderScenarioLabel();
 
-    void spawnPipe();
+    void agentReset(std::uint64_t seed) override;
+    void agentStep(bool flap) override;
+    const SimWorld& agentWorld() const override { return world; }
+
     void resetGame();
+    void flapBird();
+    void finishRecording();
     void loadHighScore();
     void saveHighScore();
     void setDifficulty(Difficulty d);
     void buildSounds();
     void buildFonts();
     void buildSkySystem();
+    void buildSkyShader();
+    void layoutSkyQuad();
     void buildClouds();
     void buildStars();
     void buildMountains();
+    void buildBackgroundCache();
     void buildGround();
     void buildUI();
+    void buildBirdAtlas();
     void spawnCloud();
     void spawnBackgroundBird();
     sf::Vector2f scale(float x, float y);
@@ -1,6 +1,6 @@
 #include "Game.h"
+#include "Log.h"
 #include <cmath>
-#include <cstdlib>
 
 const float PI_I = 3.14159265f;
 
@@ -20,10 +20,11 @@ void Game::buildSkySystem() {
 
     skyVertices.setPrimitiveType(sf::Quads);
     skyVertices.resize(4);
-    skyVertices[0].position = sf::Vector2f(0, 0);
-    skyVertices[1].position = sf::Vector2f((float)windowWidth, 0);
-    skyVertices[2].position = sf::Vector2f((float)windowWidth, (float)windowHeight);
-    skyVertices[3].position = sf::Vector2f(0, (float)windowHeight);
+    skyVertices[0].texCoords = sf::Vector2f(0, 0);
+    skyVertices[1].texCoords = sf::Vector2f(1, 0);
+    skyVertices[2].texCoords = sf::Vector2f(1, 1);
+    skyVertices[3].texCoords = sf::Vector2f(0, 1);
+    layoutSkyQuad();
 
     // Sun / small moon
     celestialBody.setRadius(32.f);
@@ -44,19 +45,64 @@ void Game::buildSkySystem() {
     bigMoonGlow.setFillColor(sf::Color(220, 230, 255, 40));
 }
 
+void Game::layoutSkyQuad() {
+    skyVertices[0].position = sf::Vector2f(0, 0);
+    skyVertices[1].position = sf::Vector2f((float)windowWidth, 0);
+    skyVertices[2].position = sf::Vector2f((float)windowWidth, (float)windowHeight);
+    skyVertices[3].position = sf::Vector2f(0, (float)windowHeight);
+}
+
+// ─── buildSkyShader() ────────────────────────────────────────────────────
+// Same three-stop gradient as the CPU path (mid stop at 45% height), mixed
+// between the outgoing and incoming scenario palettes by blendT. A low sun
+// warms the lower sky, scaled by how bright the sky is so nights stay dark.
+static const char* SKY_VERT = R"(
+void main() {
+    gl_Position    = gl_ModelViewProjectionMatrix * gl_Vertex;
+    gl_TexCoord[0] = gl_MultiTexCoord0;
+}
+)";
+
+static const char* SKY_FRAG = R"(
+uniform vec4  fromTop, fromMid, fromBot;
+uniform vec4  toTop, toMid, toBot;
+uniform float blend;
+uniform float sunHeight;
+
+vec3 gradient(vec4 top, vec4 mid, vec4 bot, float v) {
+    return v < 0.45 ? mix(top.rgb, mid.rgb, v / 0.45)
+                    : mix(mid.rgb, bot.rgb, (v - 0.45) / 0.55);
+}
+
+void main() {
+    float v = gl_TexCoord[0].y;
+    vec3  c = mix(gradient(fromTop, fromMid, fromBot, v),
+                  gradient(toTop,   toMid,   toBot,   v), blend);
+    float low   = pow(1.0 - abs(sunHeight), 4.0);
+    float light = dot(c, vec3(0.299, 0.587, 0.114));
+    c = mix(c, vec3(1.0, 0.55, 0.25), 0.35 * low * light * v * v);
+    gl_FragColor = vec4(c, 1.0);
+}
+)";
+
+void Game::buildSkyShader() {
+    skyShaderReady = sf::Shader::isAvailable() && skyShader.loadFromMemory(SKY_VERT, SKY_FRAG);
+    if (!skyShaderReady) logLine("sky: shaders unavailable, using the CPU gradient");
+}
+
 // ─── buildClouds() ───────────────────────────────────────────────────────
 void Game::createCloudTexture(int index) {
     sf::RenderTexture rt;
     if (!rt.create(140, 70)) return;
     rt.clear(sf::Color::Transparent);
-    int numCircles = 6 + (std::rand() % 3);
+    int numCircles = 6 + cosmeticRng.below(3);
     for (int i = 0; i < numCircles; ++i) {
         sf::CircleShape puff;
-        float r = 18.f + (std::rand() % 16);
+        float r = 18.f + cosmeticRng.below(16);
         puff.setRadius(r);
         puff.setOrigin(r, r);
-        puff.setPosition(30.f + (std::rand() % 80), 30.f + (std::rand() % 20));
-        int brightness = 240 + (std::rand() % 16);
+        puff.setPosition(30.f + cosmeticRng.below(80), 30.f + cosmeticRng.below(20));
+        int brightness = 240 + cosmeticRng.below(16);
         puff.setFillColor(sf::Color(brightness, brightness, brightness, 210));
         rt.draw(puff);
     }
@@ -72,38 +118,25 @@ void Game::buildClouds() {
 
 void Game::spawnCloud() {
     Cloud c;
-    c.depth  = 0.3f + (static_cast<float>(std::rand()) / RAND_MAX) * 0.7f;
+    c.depth  = 0.3f + cosmeticRng.uniform() * 0.7f;
     c.speed  = 18.f * c.depth;
     c.alpha  = 140.f + 50.f * c.depth;
-    int texI = std::rand() % 3;
+    int texI = cosmeticRng.below(3);
     c.texture= &cloudTextures[texI];
     c.sprite.setTexture(*c.texture);
     c.sprite.setColor(sf::Color(255,255,255,static_cast<sf::Uint8>(c.alpha)));
     float sc = 0.6f + c.depth * 0.5f;
     c.sprite.setScale(sc, sc);
     c.x = static_cast<float>(windowWidth) + 100.f;
-    c.y = 40.f + (std::rand() % (windowHeight / 2 - 80));
+    c.y = 40.f + cosmeticRng.below(windowHeight / 2 - 80);
     c.sprite.setPosition(c.x, c.y);
     clouds.push_back(c);
 }
 
 // ─── buildStars() ────────────────────────────────────────────────────────
 void Game::buildStars() {
-    stars.clear();
-    // 80 stars for density in BLACK_NIGHT
-    for (int i = 0; i < 80; ++i) {
-        Star s;
-        float r = 1.f + (std::rand() % 2);
-        s.shape.setRadius(r);
-        s.shape.setOrigin(r, r);
-        s.shape.setFillColor(sf::Color(255, 255, 255, 180));
-        s.shape.setPosition(
-            static_cast<float>(std::rand() % windowWidth),
-            static_cast<float>(std::rand() % (windowHeight / 2)));
-        s.twinklePhase = static_cast<float>(std::rand() % 100) / 10.f;
-        s.twinkleSpeed = 0.5f + (static_cast<float>(std::rand()) / RAND_MAX) * 1.5f;
-        stars.push_back(s);
-    }
+    starField.build(starCount, static_cast<float>(windowWidth),
+                    static_cast<float>(windowHeight / 2), cosmeticRng);
 }
 
 // ─── buildMountains() ────────────────────────────────────────────────────
@@ -112,8 +145,8 @@ void Game::buildMountains() {
     for (int i = 0; i < 8; ++i) {
         Mountain m;
         m.shape.setPointCount(3);
-        float baseW = 180.f + (std::rand() % 100);
-        float height= 120.f + (std::rand() % 80);
+        float baseW = 180.f + cosmeticRng.below(100);
+        float height= 120.f + cosmeticRng.below(80);
         m.shape.setPoint(0, sf::Vector2f(0, 0));
         m.shape.setPoint(1, sf::Vector2f(baseW/2.f, -height));
         m.shape.setPoint(2, sf::Vector2f(baseW, 0));
@@ -129,8 +162,8 @@ void Game::buildMountains() {
     for (int i = 0; i < 8; ++i) {
         Mountain m;
         m.shape.setPointCount(3);
-        float baseW = 200.f + (std::rand() % 120);
-        float height= 140.f + (std::rand() % 100);
+        float baseW = 200.f + cosmeticRng.below(120);
+        float height= 140.f + cosmeticRng.below(100);
         m.shape.setPoint(0, sf::Vector2f(0, 0));
         m.shape.setPoint(1, sf::Vector2f(baseW/2.f, -height));
         m.shape.setPoint(2, sf::Vector2f(baseW, 0));
@@ -144,6 +177,22 @@ void Game::buildMountains() {
     }
 }
 
+// ─── buildBackgroundCache() ──────────────────────────────────────────────
+// (Re)creates the cache textures for the current window size; everything
+// is baked on the next frame
+void Game::buildBackgroundCache() {
+    backgroundCached = skyLayer.create(windowWidth, windowHeight);
+    for (int layer = 0; layer < 2 && backgroundCached; ++layer) {
+        backgroundCached = mountainStrip[layer].create(static_cast<unsigned>(MOUNTAIN_WRAP), MOUNTAIN_STRIP_H);
+        mountainStrip[layer].setRepeated(true);
+        mountainStrip[layer].setSmooth(true);
+    }
+    skyLayerDirty  = true;
+    mountainsDirty = true;
+    if (backgroundFrames == 0 && !backgroundCached)
+        logLine("background: render textures unavailable, drawing layers live");
+}
+
 // ─── buildGround() ───────────────────────────────────────────────────────
 void Game::buildGround() {
     ground.setSize({static_cast<float>(windowWidth * 2), 80.f});
@@ -152,10 +201,12 @@ void Game::buildGround() {
     ground.setOutlineThickness(3.f);
     groundX[0] = 0.f;
     groundX[1] = static_cast<float>(windowWidth);
+    prevGroundX[0] = groundX[0];
+    prevGroundX[1] = groundX[1];
 
     for (int i = 0; i < 10; ++i) {
-        groundDecor[i].setSize({30.f + (std::rand() % 20),
-                                 4.f + (std::rand() % 3)});
+        groundDecor[i].setSize({30.f + cosmeticRng.below(20),
+                                 4.f + cosmeticRng.below(3)});
         groundDecor[i].setFillColor(sf::Color(100, 200, 60, 180));
     }
 }
@@ -185,12 +236,19 @@ void Game::buildUI() {
     rippleAlpha = 0.f;
 }
 
+// ─── buildBirdAtlas() ────────────────────────────────────────────────────
+// Bakes the bird rig into one texture; without it the rig draws as shapes
+void Game::buildBirdAtlas() {
+    if (birdAtlas.build()) bird.setAtlas(&birdAtlas);
+    else logLine("bird: atlas unavailable, drawing the vector rig");
+}
+
 // ─── spawnBackgroundBird() ───────────────────────────────────────────────
 void Game::spawnBackgroundBird() {
     BackgroundBird bb;
     bb.x = static_cast<float>(windowWidth) + 50.f;
-    bb.y = 80.f + (std::rand() % (windowHeight / 3));
-    bb.speed     = 40.f + (std::rand() % 40);
+    bb.y = 80.f + cosmeticRng.below(windowHeight / 3);
+    bb.speed     = 40.f + cosmeticRng.below(40);
     bb.wingPhase = 0.f;
     for (int i = 0; i < 2; ++i) {
         bb.shape[i].setPointCount(3);
@@ -9,18 +9,37 @@ const float PI_R = 3.14159265f;
 void Game::render() {
     window.clear();
 
-    renderSky();
-    renderCelestial();
-    if (scenarioHasStars(currentScenario)) renderStars();
-    renderMountains();
+    // Interpolate the bird between the last two ticks (alpha is 1 in variable-step mode)
+    const SimBird& cur = world.getBird();
+    SimBird shown  = cur;
+    shown.y        = lerpTick(prevBird.y, cur.y);
+    shown.rotation = lerpTick(prevBird.rotation, cur.rotation);
+    bird.sync(shown);
+
+    renderBackground();
     renderClouds();
     renderBackgroundBirds();
     renderGround();
 
+    const bool attract = state == GameState::MENU && attractMode;
     if (state == GameState::PLAYING  ||
         state == GameState::GAMEOVER ||
-        state == GameState::PAUSED) {
-        for (auto& p : pipes) p.draw(window);
+        state == GameState::PAUSED   || attract) {
+        // Pipes move at a constant speed, so their previous x is implied
+        float back = (state == GameState::PLAYING || attract)
+                   ? world.getPipeSpeed() * lastStepDt * (1.f - renderAlpha) : 0.f;
+        const PipeRing& pipes = world.getPipes();
+        pipeBatch.clear();
+        for (int i = 0; i < pipes.size(); ++i) {
+            const SimPipe& p = pipes[i];
+            pipeBatch.add(p.x + back, p.topY, p.botY, world.getGroundY());
+        }
+        pipeBatch.draw(window);
+        if (state == GameState::PLAYING) {
+            ++playingFrames;
+            pipeDrawCalls      += pipeBatch.getPipeCount() > 0 ? 1 : 0;
+            pipeShapeDrawCalls += static_cast<std::uint64_t>(pipeBatch.getShapeDrawCalls());
+        }
     }
 
     bird.draw(window);
@@ -42,8 +61,110 @@ void Game::render() {
     window.display();
 }
 
+float Game::lerpTick(float prev, float cur) const {
+    return prev + (cur - prev) * renderAlpha;
+}
+
+// ─── Background ───────────────────────────────────────────────────────────
+// Cached: one sprite for sky + big moon (none when the shader draws the sky
+// outside MOON), the stars in one draw, the live sun/moon arc, and one quad
+// per mountain range. Stars sit under the arc body.
+void Game::renderBackground() {
+    if (!backgroundCached) {
+        renderSky(window);
+        if (currentScenario == SkyScenario::MOON) renderBigMoon(window);
+        if (scenarioHasStars(currentScenario)) renderStars(window);
+        if (currentScenario != SkyScenario::MOON) renderCelestial();
+        renderMountains();
+        return;
+    }
+
+    ++backgroundFrames;
+    if (skyLayerDirty)  bakeSkyLayer();
+    if (mountainsDirty) bakeMountains();
+
+    // Layers baked over transparent hold premultiplied alpha: the mountain
+    // strips, and the sky layer when the shader draws the gradient live
+    const sf::RenderStates premultiplied(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha));
+    if (skyShaderReady) {
+        renderSky(window);
+        if (currentScenario == SkyScenario::MOON)
+            window.draw(sf::Sprite(skyLayer.getTexture()), premultiplied);
+    } else {
+        window.draw(sf::Sprite(skyLayer.getTexture()), sf::RenderStates(sf::BlendNone));
+    }
+    if (scenarioHasStars(currentScenario)) renderStars(window);
+    if (currentScenario != SkyScenario::MOON) renderCelestial();
+
+    const float W   = static_cast<float>(windowWidth);
+    const float top = static_cast<float>(windowHeight) - 80.f - (MOUNTAIN_STRIP_H - 6);
+    const float bot = top + MOUNTAIN_STRIP_H;
+    for (int layer = 0; layer < 2; ++layer) {
+        float u = std::fmod(mountainBakeX[layer] - mountains[layer][0].baseX, MOUNTAIN_WRAP);
+        if (u < 0.f) u += MOUNTAIN_WRAP;
+        const sf::Vertex quad[4] = {
+            sf::Vertex(sf::Vector2f(0.f, top), sf::Vector2f(u,     0.f)),
+            sf::Vertex(sf::Vector2f(W,   top), sf::Vector2f(u + W, 0.f)),
+            sf::Vertex(sf::Vector2f(W,   bot), sf::Vector2f(u + W, static_cast<float>(MOUNTAIN_STRIP_H))),
+            sf::Vertex(sf::Vector2f(0.f, bot), sf::Vector2f(u,     static_cast<float>(MOUNTAIN_STRIP_H))),
+        };
+        sf::RenderStates states = premultiplied;
+        states.texture = &mountainStrip[layer].getTexture();
+        window.draw(quad, 4, sf::Quads, states);
+    }
+}
+
+void Game::bakeSkyLayer() {
+    if (skyShaderReady) skyLayer.clear(sf::Color::Transparent);
+    else                renderSky(skyLayer);
+    if (currentScenario == SkyScenario::MOON) renderBigMoon(skyLayer);
+    skyLayer.display();
+    skyLayerDirty = false;
+    ++skyBakes;
+}
+
+// Each mountain lands at its baseX modulo the wrap, drawn twice so the one
+// straddling the seam shows on both edges. The strip's base line sits 6 px
+// above its bottom to leave room for the outline.
+void Game::bakeMountains() {
+    const float base = static_cast<float>(MOUNTAIN_STRIP_H - 6);
+    for (int layer = 0; layer < 2; ++layer) {
+        sf::RenderTexture& strip = mountainStrip[layer];
+        strip.clear(sf::Color::Transparent);
+        const sf::Color color = mountainColor(layer);
+        for (const auto& m : mountains[layer]) {
+            float x = std::fmod(m.baseX, MOUNTAIN_WRAP);
+            if (x < 0.f) x += MOUNTAIN_WRAP;
+            auto shape = m.shape;
+            shape.setFillColor(color);
+            shape.setPosition(x, base);
+            strip.draw(shape);
+            shape.setPosition(x - MOUNTAIN_WRAP, base);
+            strip.draw(shape);
+        }
+        strip.display();
+        mountainBakeX[layer] = mountains[layer][0].baseX;
+    }
+    mountainsDirty = false;
+}
+
 // ─── Sky ──────────────────────────────────────────────────────────────────
-void Game::renderSky() {
+void Game::renderSky(sf::RenderTarget& target) {
+    if (skyShaderReady) {
+        // Outside a cross-fade both palettes are the settled sky
+        skyShader.setUniform("fromTop", sf::Glsl::Vec4(isBlending ? fromTop : sky.top));
+        skyShader.setUniform("fromMid", sf::Glsl::Vec4(isBlending ? fromMid : sky.mid));
+        skyShader.setUniform("fromBot", sf::Glsl::Vec4(isBlending ? fromBot : sky.bottom));
+        skyShader.setUniform("toTop",   sf::Glsl::Vec4(isBlending ? toTop : sky.top));
+        skyShader.setUniform("toMid",   sf::Glsl::Vec4(isBlending ? toMid : sky.mid));
+        skyShader.setUniform("toBot",   sf::Glsl::Vec4(isBlending ? toBot : sky.bottom));
+        skyShader.setUniform("blend",   isBlending ? blendT : 0.f);
+        // Same arc as renderCelestial(): 1 at the top, 0 on the horizon
+        skyShader.setUniform("sunHeight", std::cos(sky.timeOfDay / 24.f * 2.f * PI_R));
+        target.draw(skyVertices, &skyShader);
+        return;
+    }
+
     float midY = windowHeight * 0.45f;
     sf::VertexArray sky3(sf::Quads, 8);
 
@@ -57,12 +178,43 @@ void Game::renderSky() {
     sky3[6] = sf::Vertex(sf::Vector2f((float)windowWidth, (float)windowHeight), sky.bottom);
     sky3[7] = sf::Vertex(sf::Vector2f(0, (float)windowHeight),            sky.bottom);
 
-    window.draw(sky3);
+    target.draw(sky3);
 }
 
 // ─── Celestial ────────────────────────────────────────────────────────────
+// Large central moon for the MOON scenario; it does not move, so it is baked
+void Game::renderBigMoon(sf::RenderTarget& target) {
+    float mx = windowWidth  * 0.65f;
+    float my = windowHeight * 0.25f;
+
+    sf::CircleShape glow(80.f);
+    glow.setOrigin(80.f, 80.f);
+    glow.setPosition(mx, my);
+    glow.setFillColor(sf::Color(220, 230, 255, 40));
+    target.draw(glow);
+
+    sf::CircleShape moon(52.f);
+    moon.setOrigin(52.f, 52.f);
+    moon.setPosition(mx, my);
+    moon.setFillColor(sf::Color(240, 245, 255));
+    moon.setOutlineColor(sf::Color(200, 215, 240, 120));
+    moon.setOutlineThickness(4.f);
+    target.draw(moon);
+
+    // Craters
+    struct Crater { float ox, oy, r; };
+    Crater craters[] = {{-18,8,6},{10,-15,4},{20,12,5},{-5,-5,3}};
+    for (auto& cr : craters) {
+        sf::CircleShape c(cr.r);
+        c.setOrigin(cr.r, cr.r);
+        c.setPosition(mx + cr.ox, my + cr.oy);
+        c.setFillColor(sf::Color(200, 208, 228));
+        target.draw(c);
+    }
+}
+
+// Sun / small moon on an arc driven by timeOfDay (every frame, drawn live)
 void Game::renderCelestial() {
-    // Arc position driven by timeOfDay
     float t     = sky.timeOfDay / 24.f;
     float angle = t * 2.f * PI_R - (PI_R / 2.f);
     float cx    = windowWidth * 0.5f;
@@ -71,38 +223,6 @@ void Game::renderCelestial() {
     float x     = cx + ar * std::cos(angle);
     float y     = cy + ar * std::sin(angle);
 
-    if (currentScenario == SkyScenario::MOON) {
-        // Large central moon for MOON scenario
-        float mx = windowWidth  * 0.65f;
-        float my = windowHeight * 0.25f;
-
-        sf::CircleShape glow(80.f);
-        glow.setOrigin(80.f, 80.f);
-        glow.setPosition(mx, my);
-        glow.setFillColor(sf::Color(220, 230, 255, 40));
-        window.draw(glow);
-
-        sf::CircleShape moon(52.f);
-        moon.setOrigin(52.f, 52.f);
-        moon.setPosition(mx, my);
-        moon.setFillColor(sf::Color(240, 245, 255));
-        moon.setOutlineColor(sf::Color(200, 215, 240, 120));
-        moon.setOutlineThickness(4.f);
-        window.draw(moon);
-
-        // Craters
-        struct Crater { float ox, oy, r; };
-        Crater craters[] = {{-18,8,6},{10,-15,4},{20,12,5},{-5,-5,3}};
-        for (auto& cr : craters) {
-            sf::CircleShape c(cr.r);
-            c.setOrigin(cr.r, cr.r);
-            c.setPosition(mx + cr.ox, my + cr.oy);
-            c.setFillColor(sf::Color(200, 208, 228));
-            window.draw(c);
-        }
-        return; // skip normal sun/moon arc for MOON scenario
-    }
-
     if (currentScenario == SkyScenario::MOONLIT_NIGHT ||
         currentScenario == SkyScenario::BLACK_NIGHT   ||
         currentScenario == SkyScenario::NIGHT         ||
@@ -125,44 +245,31 @@ void Game::renderCelestial() {
 }
 
 // ─── Stars ────────────────────────────────────────────────────────────────
-void Game::renderStars() {
+void Game::renderStars(sf::RenderTarget& target) {
     // More stars for BLACK_NIGHT
-    float densityMul = (currentScenario == SkyScenario::BLACK_NIGHT) ? 1.f : 0.6f;
-
-    for (size_t i = 0; i < stars.size(); ++i) {
-        if (currentScenario != SkyScenario::BLACK_NIGHT && i % 2 == 0) continue;
-        auto& s = stars[i];
-        float alpha = (80.f + 120.f * std::sin(s.twinklePhase)) * densityMul;
-        sf::Color c = s.shape.getFillColor();
-        c.a = static_cast<sf::Uint8>(std::min(255.f, alpha));
-        s.shape.setFillColor(c);
-        window.draw(s.shape);
-    }
+    if (currentScenario == SkyScenario::BLACK_NIGHT) starField.draw(target, starField.getCount(), 1.f);
+    else                                             starField.draw(target, SPARSE_STARS, 0.6f);
 }
 
 // ─── Mountains ────────────────────────────────────────────────────────────
-void Game::renderMountains() {
-    // Tint mountains based on scenario
-    sf::Color farColor  = sf::Color(52, 73, 94, 200);
-    sf::Color nearColor = sf::Color(127, 140, 141, 220);
-
-    if (currentScenario == SkyScenario::MORNING || currentScenario == SkyScenario::EVENING) {
-        farColor  = sf::Color(120, 60, 30, 180);
-        nearColor = sf::Color(160, 90, 50, 210);
-    } else if (scenarioHasStars(currentScenario)) {
-        farColor  = sf::Color(20, 30, 55, 200);
-        nearColor = sf::Color(30, 45, 75, 220);
-    }
+// Tint mountains based on scenario
+sf::Color Game::mountainColor(int layer) {
+    if (currentScenario == SkyScenario::MORNING || currentScenario == SkyScenario::EVENING)
+        return layer == 0 ? sf::Color(120, 60, 30, 180) : sf::Color(160, 90, 50, 210);
+    if (scenarioHasStars(currentScenario))
+        return layer == 0 ? sf::Color(20, 30, 55, 200) : sf::Color(30, 45, 75, 220);
+    return layer == 0 ? sf::Color(52, 73, 94, 200) : sf::Color(127, 140, 141, 220);
+}
 
-    for (auto& m : mountains[0]) {
-        auto shape = m.shape;
-        shape.setFillColor(farColor);
-        window.draw(shape);
-    }
-    for (auto& m : mountains[1]) {
-        auto shape = m.shape;
-        shape.setFillColor(nearColor);
-        window.draw(shape);
+// Live fallback when the cache has no render textures
+void Game::renderMountains() {
+    for (int layer = 0; layer < 2; ++layer) {
+        const sf::Color color = mountainColor(layer);
+        for (auto& m : mountains[layer]) {
+            auto shape = m.shape;
+            shape.setFillColor(color);
+            window.draw(shape);
+        }
     }
 }
 
@@ -203,19 +310,26 @@ void Game::renderGround() {
     }
     ground.setFillColor(groundCol);
 
+    // Interpolated scroll; skip the blend across a wrap-around
+    float gx[2];
     for (int i = 0; i < 2; ++i) {
-        ground.setPosition(groundX[i], groundY);
+        gx[i] = (std::abs(groundX[i] - prevGroundX[i]) > windowWidth)
+              ? groundX[i] : lerpTick(prevGroundX[i], groundX[i]);
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        ground.setPosition(gx[i], groundY);
         window.draw(ground);
     }
     sf::RectangleShape grass;
     grass.setSize({static_cast<float>(windowWidth * 2), 14.f});
     grass.setFillColor(grassCol);
     for (int i = 0; i < 2; ++i) {
-        grass.setPosition(groundX[i], groundY);
+        grass.setPosition(gx[i], groundY);
         window.draw(grass);
     }
     for (int i = 0; i < 10; ++i) {
-        float x = groundX[0] + (i * 80.f);
+        float x = gx[0] + (i * 80.f);
         if (x > windowWidth) x -= windowWidth * 2;
         groundDecor[i].setPosition(x, groundY + 8.f);
         window.draw(groundDecor[i]);
@@ -227,7 +341,7 @@ void Game::renderHUD() {
     float W = static_cast<float>(windowWidth);
 
     // ── Score: top-centre ─────────────────────────────────────────────────
-    scoreText.setString(std::to_string(score));
+    scoreText.setString(std::to_string(world.getScore()));
     sf::FloatRect sb = scoreText.getLocalBounds();
     scoreText.setOrigin(sb.left + sb.width / 2.f, sb.top);
     scoreText.setPosition(W / 2.f, 14.f);
@@ -403,6 +517,7 @@ void Game::renderPause() {
 void Game::renderGameOver() {
     float cX = windowWidth  / 2.f;
     float cY = windowHeight / 2.f;
+    int score = world.getScore();
 
     sf::RectangleShape panel;
     panel.setSize({350.f, 340.f});
@@ -476,6 +591,17 @@ void Game::renderGameOver() {
     restartText.setOrigin(rb.left + rb.width/2.f, rb.top);
     restartText.setPosition(cX, cY + 92.f);
     window.draw(restartText);
+
+    // Seed: replay this exact course with --seed
+    sf::Text seedText;
+    seedText.setFont(fontMain);
+    seedText.setCharacterSize(14);
+    seedText.setFillColor(sf::Color(190,190,190));
+    seedText.setString("Seed: " + std::to_string(runSeed));
+    sf::FloatRect sdb = seedText.getLocalBounds();
+    seedText.setOrigin(sdb.left + sdb.width/2.f, sdb.top);
+    seedText.setPosition(cX, cY + 124.f);
+    window.draw(seedText);
 }
 
 // ─── Touch Indicator ──────────────────────────────────────────────────────
@@ -0,0 +1,22 @@
+#include "Log.h"
+#include <cstdarg>
+#include <cstdio>
+
+static const char* LOG_PATH = "flappy.log";
+
+void logLine(const char* fmt, ...) {
+    static std::FILE* file = std::fopen(LOG_PATH, "w");
+    va_list args;
+    va_start(args, fmt);
+    if (file) {
+        va_list copy;
+        va_copy(copy, args);
+        std::vfprintf(file, fmt, copy);
+        va_end(copy);
+        std::fputc('\n', file);
+        std::fflush(file);
+    }
+    std::vprintf(fmt, args);
+    std::putchar('\n');
+    va_end(args);
+}
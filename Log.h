@@ -0,0 +1,12 @@
+#pragma once
+
+// ─── Session log ──────────────────────────────────────────────────────────
+// The game links with -mwindows, so it has no console. Notices and the exit
+// report go to flappy.log next to highscore.dat, rewritten each run, and to
+// stdout as well for builds that do have one. One line per call, newline
+// added.
+void logLine(const char* fmt, ...)
+#if defined(__GNUC__)
+    __attribute__((format(printf, 1, 2)))
+#endif
+    ;
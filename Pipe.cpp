@@ -1,91 +1,56 @@
 #include "Pipe.h"
 
-float Pipe::GAP   = 165.f;
-float Pipe::WIDTH = 72.f;
-float Pipe::SPEED = 180.f;
+static const float WIDTH   = SimWorld::PIPE_WIDTH;
+static const float CAP_H   = SimWorld::PIPE_CAP_H;
+static const float OUTLINE = SimWorld::PIPE_OUTLINE;
 
-static const float CAP_H = 28.f;
+static const sf::Color PIPE_GREEN(78, 192, 46);
+static const sf::Color PIPE_OUTLINE(40, 120, 20);
+static const sf::Color CAP_GREEN(58, 160, 30);
 
-Pipe::Pipe(float x, float gapY, float windowHeight)
-    : x(x), gapY(gapY), windowHeight(windowHeight), passed(false)
+PipeBatch::PipeBatch()
+    : vertices(sf::Quads, static_cast<std::size_t>(SIM_MAX_PIPES * VERTS_PER_PIPE)), used(0), pipes(0)
 {
-    sf::Color pipeGreen(78, 192, 46);
-    sf::Color pipeOutline(40, 120, 20);
-    sf::Color capGreen(58, 160, 30);
-
-    // Top body
-    topBody.setFillColor(pipeGreen);
-    topBody.setOutlineColor(pipeOutline);
-    topBody.setOutlineThickness(3.f);
-
-    // Top cap
-    topCap.setSize({ WIDTH + 12.f, CAP_H });
-    topCap.setFillColor(capGreen);
-    topCap.setOutlineColor(pipeOutline);
-    topCap.setOutlineThickness(3.f);
-
-    // Bottom body
-    botBody.setFillColor(pipeGreen);
-    botBody.setOutlineColor(pipeOutline);
-    botBody.setOutlineThickness(3.f);
-
-    // Bottom cap
-    botCap.setSize({ WIDTH + 12.f, CAP_H });
-    botCap.setFillColor(capGreen);
-    botCap.setOutlineColor(pipeOutline);
-    botCap.setOutlineThickness(3.f);
-
-    updateShapes();
 }
 
-void Pipe::update(float dt) {
-    x -= SPEED * dt;
-    updateShapes();
+void PipeBatch::clear() {
+    used  = 0;
+    pipes = 0;
 }
 
-void Pipe::draw(sf::RenderWindow& window) {
-    window.draw(topBody);
-    window.draw(topCap);
-    window.draw(botBody);
-    window.draw(botCap);
+void PipeBatch::addQuad(float l, float t, float r, float b, sf::Color color) {
+    vertices[used++] = sf::Vertex(sf::Vector2f(l, t), color);
+    vertices[used++] = sf::Vertex(sf::Vector2f(r, t), color);
+    vertices[used++] = sf::Vertex(sf::Vector2f(r, b), color);
+    vertices[used++] = sf::Vertex(sf::Vector2f(l, b), color);
 }
 
-bool Pipe::isOffScreen() const {
-    return x + WIDTH < 0.f;
+// The outline lies outside the rect: bands above and below span the full
+// outer width, the side bands fill in between. Corners are offset from the
+// local rect first and then moved, in the order the shape's transform does.
+void PipeBatch::addRect(float x, float y, float w, float h, sf::Color fill) {
+    const float o  = OUTLINE;
+    const float l = x - o,       t = y - o;
+    const float r = x + (w + o), b = y + (h + o);
+    addQuad(x,     y,     x + w, y + h, fill);
+    addQuad(l,     t,     r,     y,     PIPE_OUTLINE);
+    addQuad(l,     y + h, r,     b,     PIPE_OUTLINE);
+    addQuad(l,     y,     x,     y + h, PIPE_OUTLINE);
+    addQuad(x + w, y,     r,     y + h, PIPE_OUTLINE);
 }
 
-bool Pipe::checkCollision(const sf::FloatRect& birdBounds) const {
-    sf::FloatRect topRect = topBody.getGlobalBounds();
-    sf::FloatRect botRect = botBody.getGlobalBounds();
-    sf::FloatRect topCapRect = topCap.getGlobalBounds();
-    sf::FloatRect botCapRect = botCap.getGlobalBounds();
-    return birdBounds.intersects(topRect)    ||
-           birdBounds.intersects(botRect)    ||
-           birdBounds.intersects(topCapRect) ||
-           birdBounds.intersects(botCapRect);
-}
+void PipeBatch::add(float x, float topY, float botY, float groundY) {
+    if (used + VERTS_PER_PIPE > vertices.getVertexCount()) return;
+    const float capX = x - SimWorld::PIPE_CAP_OVERHANG;
+    const float capW = WIDTH + 2.f * SimWorld::PIPE_CAP_OVERHANG;
 
-bool Pipe::hasPassed(float birdX) const {
-    return !passed && (x + WIDTH < birdX);
+    addRect(x,    0.f,          WIDTH, topY,           PIPE_GREEN);   // top body
+    addRect(capX, topY - CAP_H, capW,  CAP_H,          CAP_GREEN);    // top cap, at the bottom of the top pipe
+    addRect(x,    botY,         WIDTH, groundY - botY, PIPE_GREEN);   // bottom body
+    addRect(capX, botY,         capW,  CAP_H,          CAP_GREEN);    // bottom cap, at the top of the bottom pipe
+    ++pipes;
 }
 
-void Pipe::updateShapes() {
-    float topH   = gapY - GAP / 2.f;
-    float botY   = gapY + GAP / 2.f;
-    float botH   = windowHeight - botY;
-    float capX   = x - 6.f;
-
-    // Top body
-    topBody.setSize({ WIDTH, topH });
-    topBody.setPosition(x, 0.f);
-
-    // Top cap (sits at the bottom of top pipe)
-    topCap.setPosition(capX, topH - CAP_H);
-
-    // Bottom body
-    botBody.setSize({ WIDTH, botH });
-    botBody.setPosition(x, botY);
-
-    // Bottom cap (sits at the top of bottom pipe)
-    botCap.setPosition(capX, botY);
+void PipeBatch::draw(sf::RenderTarget& target) {
+    if (used > 0) target.draw(&vertices[0], used, sf::Quads);
 }
@@ -1,28 +1,35 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "SimWorld.h"
 
-class Pipe {
+// Presentation for the world's pipes; the rules themselves live in SimWorld.
+// Every pipe's two bodies and two caps, each with its 3 px outline, are
+// written into one pre-sized vertex array and drawn in a single call. The
+// rects and their stacking order (top body, top cap, bottom body, bottom
+// cap; fill, then outline) are those of the outlined sf::RectangleShapes
+// this replaces, so the frame is the same pixel for pixel.
+class PipeBatch {
 public:
-    static float GAP;       // gap between top and bottom pipe
-    static float WIDTH;
-    static float SPEED;
+    PipeBatch();
 
-    Pipe(float x, float gapY, float windowHeight);
+    void clear();
+    void add(float x, float topY, float botY, float groundY);
+    void draw(sf::RenderTarget& target);
 
-    void update(float dt);
-    void draw(sf::RenderWindow& window);
-    bool isOffScreen() const;
-    bool checkCollision(const sf::FloatRect& birdBounds) const;
-    bool hasPassed(float birdX) const;
-    void markPassed() { passed = true; }
-    float getX() const { return x; }
+    int getPipeCount() const { return pipes; }
+    // What the same pipes cost drawn as four outlined shapes each (fill
+    // and outline are separate draws)
+    int getShapeDrawCalls() const { return pipes * 8; }
 
 private:
-    float x, gapY, windowHeight;
-    bool  passed;
+    // Fill quad plus four outline bands, corners squared off as SFML does
+    static constexpr int VERTS_PER_RECT = 4 * 5;
+    static constexpr int VERTS_PER_PIPE = VERTS_PER_RECT * 4;
 
-    sf::RectangleShape topBody, topCap;
-    sf::RectangleShape botBody, botCap;
+    sf::VertexArray vertices;
+    std::size_t     used;
+    int             pipes;
 
-    void updateShapes();
+    void addRect(float x, float y, float w, float h, sf::Color fill);
+    void addQuad(float l, float t, float r, float b, sf::Color color);
 };
@@ -0,0 +1,440 @@
+#include "Reachability.h"
+#include "Collision.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// ─── Course trace ─────────────────────────────────────────────────────────
+void traceCourse(SimWorld& world, int pipeCount, float dt, CourseTrace& out) {
+    out.lo.clear();
+    out.hi.clear();
+    out.pipe.clear();
+
+    // The bird's box relative to its centre; it never moves horizontally
+    const SimBird& bird = world.getBird();
+    const SimRect  bb   = bird.getBounds();
+    const float    up   = bird.y - bb.top;
+    const float    down = (bb.top + bb.height) - bird.y;
+    const float    o    = SimWorld::PIPE_OUTLINE;
+
+    for (;;) {
+        world.stepCourse(dt);
+        const PipeRing& pipes = world.getPipes();
+        float lo = 0.f, hi = world.getGroundY();
+        int   pipe = world.getScore();
+        bool  clear = true;
+        // Pipes are ordered by x; passed ones are a prefix of the ring
+        for (int i = 0; i < pipes.size(); ++i) {
+            const SimPipe& p = pipes[i];
+            if (pipeRight(p.x) <= bb.left) continue;
+            if (pipeLeft(p.x) >= bb.left + bb.width) break;
+            // Caps and bodies share their inner edges, so the gap is the band
+            lo = std::max(lo, p.topY + o + up);
+            hi = std::min(hi, p.botY - o - down);
+            int passed = 0;
+            while (passed < pipes.size() && pipes[passed].passed) ++passed;
+            pipe  = world.getScore() - passed + i;
+            clear = false;
+        }
+        if (clear && world.getScore() >= pipeCount) break;
+        out.lo.push_back(lo);
+        out.hi.push_back(hi);
+        out.pipe.push_back(pipe);
+    }
+}
+
+// ─── ReachSolver ──────────────────────────────────────────────────────────
+namespace {
+
+// Bits lo..hi of a word
+inline std::uint64_t bitRange(int lo, int hi) {
+    return (~0ull >> (63 - hi)) & (~0ull << lo);
+}
+
+} // namespace
+
+ReachSolver::ReachSolver(float groundY, float dt, float binSize)
+    : groundY(groundY), binSize(binSize), invBin(1.f / binSize), dt(dt), live(0), tick(0),
+      freeY(0.f), freeV(0.f), freeAlive(false)
+{
+    SimBird proto;
+    gravity = proto.gravity;
+
+    // Same float steps as SimBird::update, starting from a flap at y = 0.
+    // Once the offset passes groundY no height survives it.
+    std::vector<float> rise(1, 0.f);
+    float v = proto.flapStrength, y = 0.f, maxStep = 0.f;
+    while (y <= groundY) {
+        v += gravity * dt;
+        y += v * dt;
+        maxStep = std::max(maxStep, std::fabs(v * dt));
+        rise.push_back(y);
+    }
+    horizon = static_cast<int>(rise.size()) - 1;
+
+    // Rows must move less than a word per tick; only very low tick rates
+    // with fine bins need coarser ones
+    if (maxStep * invBin >= 62.f) {
+        this->binSize = maxStep / 62.f;
+        invBin        = 1.f / this->binSize;
+    }
+
+    // A row is binned once, at the flap, and then follows the rounded
+    // offsets, so rounding never accumulates
+    int prev = 0;
+    fall.push_back(0);
+    for (int j = 1; j <= horizon; ++j) {
+        int s = static_cast<int>(std::floor(rise[j] * invBin + 0.5f));
+        fall.push_back(s - prev);
+        prev = s;
+    }
+
+    bins   = static_cast<int>(groundY * invBin) + 1;
+    words  = (bins + 63) / 64;
+    stride = words + 2;
+    int ring = 1;
+    while (ring < horizon + 2) ring <<= 1;
+    ringMask = ring - 1;
+
+    rows.assign(static_cast<std::size_t>(ring) * stride, 0ull);
+    rowFirst.resize(ring);
+    rowLast.resize(ring);
+    order.resize(ring);
+    flaps.assign(words, 0ull);
+
+    // Rows younger than this come back after every pipe (see solveCourse)
+    settledAge = std::min(horizon, static_cast<int>(SETTLED_SECONDS / dt));
+}
+
+void ReachSolver::begin(float startY, float startVelocity) {
+    std::fill(flaps.begin(), flaps.end(), 0ull);
+    live      = 0;
+    tick      = 0;
+    freeY     = startY;
+    freeV     = startVelocity;
+    freeAlive = true;
+}
+
+void ReachSolver::bandBins(float lo, float hi, int& bLo, int& bHi) const {
+    // Bin b (centre (b + 0.5) * binSize) must lie in [lo, hi]
+    bLo = std::max(static_cast<int>(std::ceil(lo * invBin - 0.5f)), 0);
+    bHi = std::min(static_cast<int>(std::floor(hi * invBin - 0.5f)), bins - 1);
+}
+
+bool ReachSolver::step(float lo, float hi) {
+    int bLo, bHi;
+    bandBins(lo, hi, bLo, bHi);
+    if (freeAlive) {
+        int b = static_cast<int>(freeY * invBin);
+        if (b >= 0 && b < bins) flaps[b >> 6] |= 1ull << (b & 63);
+    }
+    advance(bLo, bHi);
+    if (freeAlive) {
+        freeV += gravity * dt;
+        freeY += freeV * dt;
+        freeAlive = freeY >= lo && freeY <= hi;
+    }
+    return isAlive();
+}
+
+void ReachSolver::advance(int bLo, int bHi) {
+    const int t = tick++;
+    const int wLo = bLo >> 6, wHi = bHi >> 6;
+    const std::uint64_t loMask = bLo <= bHi ? bitRange(bLo & 63, 63) : 0ull;
+    const std::uint64_t hiMask = bLo <= bHi ? bitRange(0, bHi & 63) : 0ull;
+
+    // Birds that flap now join as the newest row, copied from `flaps`
+    int fFirst = words, fLast = -1;
+    for (int w = 0; w < words; ++w)
+        if (flaps[w]) { fFirst = std::min(fFirst, w); fLast = w; }
+    if (fLast >= 0) {
+        std::uint64_t* r = row(t);
+        std::copy(flaps.begin(), flaps.end(), r);
+        rowFirst[t & ringMask] = fFirst;
+        rowLast[t & ringMask]  = fLast;
+        order[live++] = t;
+    }
+    std::fill(flaps.begin(), flaps.end(), 0ull);
+
+    // Every row falls its own distance for this tick, keeps only the band
+    // and adds its heights to next tick's flaps. Rows move under a word per
+    // tick, so a word reads only itself and one neighbour, and the update
+    // runs in place: high words first when moving down, low words first
+    // when moving up. A row that ends up empty is gone for good.
+    int kept = 0;
+    for (int k = 0; k < live; ++k) {
+        const int tau = order[k];
+        const int j   = t - tau + 1;
+        if (j > horizon) continue;
+        std::uint64_t* r = row(tau);
+        const int i     = tau & ringMask;
+        const int d     = fall[j];
+        const int first = rowFirst[i], last = rowLast[i];
+        const int w0    = std::max(d < 0 ? first - 1 : first, wLo);
+        const int w1    = std::min(d > 0 ? last + 1 : last, wHi);
+        int nFirst = words, nLast = -1;
+        if (d >= 0) {
+            for (int w = last; w > w1; --w) r[w] = 0ull;
+            for (int w = w1; w >= w0; --w) {
+                std::uint64_t v = d ? (r[w] << d) | (r[w - 1] >> (64 - d)) : r[w];
+                if (w == wLo) v &= loMask;
+                if (w == wHi) v &= hiMask;
+                r[w] = v;
+                if (v) { nFirst = w; if (nLast < 0) nLast = w; }
+            }
+            for (int w = std::min(w0 - 1, last); w >= first; --w) r[w] = 0ull;
+        } else {
+            for (int w = first; w < w0; ++w) r[w] = 0ull;
+            for (int w = w0; w <= w1; ++w) {
+                std::uint64_t v = (r[w] >> -d) | (r[w + 1] << (64 + d));
+                if (w == wLo) v &= loMask;
+                if (w == wHi) v &= hiMask;
+                r[w] = v;
+                if (v) { nLast = w; if (nFirst == words) nFirst = w; }
+            }
+            for (int w = std::max(w1 + 1, first); w <= last; ++w) r[w] = 0ull;
+        }
+        if (nLast < 0) continue;
+        for (int w = nFirst; w <= nLast; ++w) flaps[w] |= r[w];
+        rowFirst[i] = nFirst;
+        rowLast[i]  = nLast;
+        order[kept++] = tau;
+    }
+    live = kept;
+}
+
+int ReachSolver::solve(float startY, const float* lo, const float* hi, int ticks) {
+    begin(startY);
+    for (int t = 0; t < ticks; ++t)
+        if (!step(lo[t], hi[t])) return t;
+    return -1;
+}
+
+// ─── Whole courses ────────────────────────────────────────────────────────
+// Pipes are far enough apart that, some time after each one, the open air
+// has refilled every height away from the ceiling and ground for birds
+// that flapped in the last SETTLED_SECONDS. Call those young rows the
+// settled state. The solver is monotone (more birds now never means fewer
+// later), so once the real state holds the settled state, any pipe plus
+// the air after it that the settled state survives on its own, ending up
+// holding it again, is survived by the real state too. Such an episode
+// depends only on its bands in bins and its length, so each distinct one
+// is solved once and remembered, and a course becomes a few table lookups.
+// Whatever the shortcut cannot vouch for (an impossible pipe, or air too
+// short to settle, deep into the ramp) is solved tick by tick, so the
+// answer is always the same as solve()'s.
+//
+// Stepping resumes at the episode that failed, not at tick 0. The real
+// state at its entry lies between what the episode before it makes of the
+// settled state and what it makes of every height on every row; a pipe
+// squeezes out the difference, so the two nearly always agree, and then
+// that is the real state. Only when they differ (or the unflapped bird is
+// still about) does the course go back to tick 0.
+
+void ReachSolver::captureSettled() {
+    // Long enough for the flap heights to fill the band and every row to
+    // be replaced
+    begin(groundY * 0.5f);
+    for (int t = 0; t < 3 * horizon; ++t) step(0.f, groundY);
+
+    int bLo, bHi;
+    bandBins(groundY * SETTLED_MARGIN, groundY * (1.f - SETTLED_MARGIN), bLo, bHi);
+    settled.assign(static_cast<std::size_t>(settledAge + 1) * words, 0ull);
+    settledFirst.assign(settledAge + 1, words);
+    settledLast.assign(settledAge + 1, -1);
+    for (int k = 0; k < live; ++k) {
+        const int tau = order[k];
+        const int age = tick - tau;
+        if (age < 1 || age > settledAge) continue;
+        const std::uint64_t* r = row(tau);
+        std::uint64_t* s = settled.data() + static_cast<std::size_t>(age) * words;
+        for (int w = bLo >> 6; w <= bHi >> 6; ++w) {
+            s[w] = r[w] & bitRange(std::max(bLo - w * 64, 0), std::min(bHi - w * 64, 63));
+            if (s[w]) { settledFirst[age] = std::min(settledFirst[age], w); settledLast[age] = w; }
+        }
+    }
+}
+
+void ReachSolver::loadSettled() {
+    std::fill(flaps.begin(), flaps.end(), 0ull);
+    live      = 0;
+    tick      = 0;
+    freeAlive = false;
+    for (int age = settledAge; age >= 1; --age) {
+        if (settledLast[age] < 0) continue;
+        const int tau = -age;
+        const std::uint64_t* src = settled.data() + static_cast<std::size_t>(age) * words;
+        std::copy(src, src + words, row(tau));
+        rowFirst[tau & ringMask] = settledFirst[age];
+        rowLast[tau & ringMask]  = settledLast[age];
+        order[live++] = tau;
+        for (int w = settledFirst[age]; w <= settledLast[age]; ++w) flaps[w] |= src[w];
+    }
+}
+
+bool ReachSolver::holdsSettled() const {
+    int need = 0, held = 0;
+    for (int age = 1; age <= settledAge; ++age)
+        if (settledLast[age] >= 0) ++need;
+    for (int k = 0; k < live; ++k) {
+        const int tau = order[k];
+        const int age = tick - tau;
+        if (age < 1 || age > settledAge || settledLast[age] < 0) continue;
+        const std::uint64_t* r = rows.data() + static_cast<std::size_t>(tau & ringMask) * stride + 1;
+        const std::uint64_t* s = settled.data() + static_cast<std::size_t>(age) * words;
+        bool holds = true;
+        for (int w = settledFirst[age]; w <= settledLast[age] && holds; ++w)
+            holds = (s[w] & ~r[w]) == 0;
+        if (holds) ++held;
+    }
+    return held == need;
+}
+
+void ReachSolver::loadFull() {
+    std::fill(flaps.begin(), flaps.end(), 0ull);
+    for (int b = 0; b < bins; ++b) flaps[b >> 6] |= 1ull << (b & 63);
+    live      = 0;
+    tick      = 0;
+    freeAlive = false;
+    for (int age = horizon; age >= 1; --age) {
+        const int tau = -age;
+        std::copy(flaps.begin(), flaps.end(), row(tau));
+        rowFirst[tau & ringMask] = 0;
+        rowLast[tau & ringMask]  = words - 1;
+        order[live++] = tau;
+    }
+}
+
+bool ReachSolver::pinEpisode(const Segment& a, const Segment& b) {
+    // Lower bound: the settled state, which the real one holds
+    loadSettled();
+    for (int t = 0; t < a.ticks; ++t) advance(a.lo, a.hi);
+    for (int t = 0; t < b.ticks; ++t) advance(b.lo, b.hi);
+    pinnedOrder.assign(order.begin(), order.begin() + live);
+    pinnedRows = rows;
+    pinnedFirst = rowFirst;
+    pinnedLast = rowLast;
+
+    // Upper bound: every height on every row still in the air
+    loadFull();
+    for (int t = 0; t < a.ticks && live > 0; ++t) advance(a.lo, a.hi);
+    for (int t = 0; t < b.ticks && live > 0; ++t) advance(b.lo, b.hi);
+    if (live != static_cast<int>(pinnedOrder.size())) return false;
+    for (int k = 0; k < live; ++k) {
+        const int tau = order[k];
+        const int i   = tau & ringMask;
+        if (tau != pinnedOrder[k] || rowFirst[i] != pinnedFirst[i] || rowLast[i] != pinnedLast[i]) return false;
+        const std::size_t at = static_cast<std::size_t>(i) * stride + 1;
+        for (int w = rowFirst[i]; w <= rowLast[i]; ++w)
+            if (rows[at + w] != pinnedRows[at + w]) return false;
+    }
+    return true;
+}
+
+int ReachSolver::solveCourse(float startY, const CourseTrace& course) {
+    const int n = static_cast<int>(course.lo.size());
+    segments.clear();
+    for (int t = 0; t < n; ++t) {
+        if (t > 0 && course.lo[t] == course.lo[t - 1] && course.hi[t] == course.hi[t - 1]) {
+            ++segments.back().ticks;
+            continue;
+        }
+        int bLo, bHi;
+        bandBins(course.lo[t], course.hi[t], bLo, bHi);
+        if (!segments.empty() && segments.back().lo == bLo && segments.back().hi == bHi)
+            ++segments.back().ticks;
+        else
+            segments.push_back(Segment{ bLo, bHi, 1 });
+    }
+    if (segments.size() < 2) return solve(startY, course.lo.data(), course.hi.data(), n);
+    if (settled.empty()) captureSettled();
+
+    // Steps the real state over course ticks [from, to)
+    auto track = [&](int from, int to) {
+        for (int t = from; t < to; ++t)
+            if (!step(course.lo[t], course.hi[t])) return t;
+        return -1;
+    };
+
+    // The opening stretch still has the unflapped bird, which checks the
+    // float band, so it is keyed on exact floats and must not vary
+    const Segment& open = segments[0];
+    bool openSettles = true;
+    for (int t = 1; t < open.ticks && openSettles; ++t)
+        openSettles = course.lo[t] == course.lo[0] && course.hi[t] == course.hi[0];
+    if (openSettles) {
+        int startBits, loBits, hiBits;
+        std::memcpy(&startBits, &startY, sizeof startBits);
+        std::memcpy(&loBits, &course.lo[0], sizeof loBits);
+        std::memcpy(&hiBits, &course.hi[0], sizeof hiBits);
+        EpisodeKey startKey{ -1, startBits, loBits, hiBits, open.ticks, 0 };
+        auto it = episodes.find(startKey);
+        if (it == episodes.end()) {
+            begin(startY);
+            for (int t = 0; t < open.ticks && isAlive(); ++t) step(course.lo[t], course.hi[t]);
+            it = episodes.emplace(startKey, holdsSettled()).first;
+        }
+        openSettles = it->second;
+    }
+
+    // While `tracking`, the solver holds the real state at `entry`;
+    // otherwise the real state is only known to hold the settled state.
+    // An episode the settled state cannot vouch for is stepped from its
+    // own entry, never from tick 0: after the opening the real state there
+    // is pinned down by the episode before it (see pinEpisode).
+    bool tracking = !openSettles;
+    if (tracking) {
+        begin(startY);
+        const int fail = track(0, open.ticks);
+        if (fail >= 0) return fail;
+    }
+    // Last tick the unflapped bird is alive; it rules out pinning until then
+    int freeLast = -1;
+    {
+        float y = startY, v = 0.f;
+        for (int t = 0; t < n; ++t) {
+            v += gravity * dt;
+            y += v * dt;
+            if (y < course.lo[t] || y > course.hi[t]) break;
+            freeLast = t;
+        }
+    }
+
+    int entry = open.ticks, prevEntry = 0;
+    for (std::size_t i = 1; i < segments.size(); i += 2) {
+        const bool    last = i + 1 == segments.size();
+        const Segment a    = segments[i];
+        const Segment b    = last ? Segment{ 0, -1, 0 } : segments[i + 1];
+        const int     exit = entry + a.ticks + b.ticks;
+        EpisodeKey key{ a.lo, a.hi, a.ticks, b.lo, b.hi, b.ticks };
+        auto it = episodes.find(key);
+        if (tracking) {
+            // Back to lookups once the real state holds the settled one
+            tracking = it == episodes.end() || !it->second || !holdsSettled();
+        } else {
+            if (it == episodes.end()) {
+                loadSettled();
+                for (int t = 0; t < a.ticks && live > 0; ++t) advance(a.lo, a.hi);
+                for (int t = 0; t < b.ticks && live > 0; ++t) advance(b.lo, b.hi);
+                it = episodes.emplace(key, last ? live > 0 : holdsSettled()).first;
+            }
+            if (!it->second) {
+                // Recover the real state at this episode's entry
+                if (i == 1) {
+                    begin(startY);
+                    track(0, open.ticks);
+                } else if (prevEntry <= freeLast || !pinEpisode(segments[i - 2], segments[i - 1])) {
+                    return solve(startY, course.lo.data(), course.hi.data(), n);
+                }
+                tracking = true;
+            }
+        }
+        if (tracking) {
+            const int fail = track(entry, exit);
+            if (fail >= 0) return fail;
+        }
+        prevEntry = entry;
+        entry     = exit;
+    }
+    return -1;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <cstdint>
+#include <initializer_list>
+#include <unordered_map>
+#include <vector>
+#include "SimWorld.h"
+
+// ─── Course reachability ──────────────────────────────────────────────────
+// Decides whether any flap sequence survives a course, without searching
+// flap sequences. After a flap the bird's velocity is fixed, so its whole
+// state is its height and the ticks since it last flapped. The solver keeps
+// one row per flap tick: a bitset of the heights at which a bird that last
+// flapped on that tick can be now. Each tick every row moves by its own
+// fall for that tick and is masked by the tick's safe band, and the OR of
+// all rows (every height a live bird is at) becomes the new row of birds
+// that flap now.
+//
+// Heights are binned (2 px by default) and only the bird's vertical band
+// per tick is checked, so the answer is exact up to the bin size: a course
+// it calls impossible can at best be beaten by a hair.
+
+// Safe band per tick for the BOX hitbox: after tick t's step the bird's y
+// must lie in [lo[t], hi[t]]. pipe[t] is the course index of the pipe the
+// bird is passing (or approaching) on that tick.
+struct CourseTrace {
+    std::vector<float> lo, hi;
+    std::vector<int>   pipe;
+};
+
+// Lays out the course of an already reset world, tick by tick, until the
+// bird is clear of its first `pipeCount` pipes. Uses SimWorld::stepCourse,
+// so spawns, scroll and the ramp follow the real rules.
+void traceCourse(SimWorld& world, int pipeCount, float dt, CourseTrace& out);
+
+class ReachSolver {
+public:
+    // Rows kept in the settled state (see Reachability.cpp): flapped within
+    // this long, at heights clear of the ceiling and ground by this share
+    static constexpr float SETTLED_SECONDS = 0.2f;
+    static constexpr float SETTLED_MARGIN  = 0.1f;
+
+    // Gravity and flap strength come from SimBird
+    ReachSolver(float groundY, float dt, float binSize = 2.f);
+
+    // Bird at startY with startVelocity, not flapped yet, before tick 0
+    void begin(float startY, float startVelocity = 0.f);
+    // One tick: the bird may flap, then must end the step inside [lo, hi].
+    // Returns false once no flap sequence survives.
+    bool step(float lo, float hi);
+    bool isAlive() const { return freeAlive || live > 0; }
+
+    // First tick nothing survives, or -1 if the bird can get through all
+    // `ticks` bands
+    int solve(float startY, const float* lo, const float* hi, int ticks);
+    // The same answer for a traced course, but each pipe (with the open air
+    // after it) is decided once per distinct layout and then remembered;
+    // see Reachability.cpp. Uses the solver's own state, so one solver per
+    // thread.
+    int solveCourse(float startY, const CourseTrace& course);
+
+    int   getHorizon() const { return horizon; }
+    float getBinSize() const { return binSize; }   // widened at very low tick rates
+
+private:
+    // A run of ticks with the same band, in bins
+    struct Segment { int lo, hi, ticks; };
+    // Two segments (a pipe and the air after it), or the course start
+    struct EpisodeKey {
+        int a, b, c, d, e, f;
+        bool operator==(const EpisodeKey& o) const {
+            return a == o.a && b == o.b && c == o.c && d == o.d && e == o.e && f == o.f;
+        }
+    };
+    struct EpisodeHash {
+        std::size_t operator()(const EpisodeKey& k) const {
+            std::uint64_t h = 1469598103934665603ull;
+            for (int v : { k.a, k.b, k.c, k.d, k.e, k.f })
+                h = (h ^ static_cast<std::uint32_t>(v)) * 1099511628211ull;
+            return static_cast<std::size_t>(h);
+        }
+    };
+
+    float groundY;
+    float binSize;
+    float invBin;
+    float dt;
+    float gravity;
+    int   bins;
+    int   words;
+    int   stride;    // words plus a zero guard word on each side
+    int   horizon;   // ticks after a flap until the bird is below the ground from anywhere
+    int   ringMask;
+
+    std::vector<int>   fall;    // bins a row moves on its j-th tick after the flap
+    std::vector<std::uint64_t> rows;    // ring of rows by flap tick, `stride` words each
+    std::vector<int>   rowFirst, rowLast;   // words outside this range are zero
+    std::vector<int>   order;   // live rows, oldest first
+    std::vector<std::uint64_t> flaps;   // heights a bird can flap from this tick
+    int   live;
+    int   tick;
+
+    float freeY, freeV;   // the bird that has not flapped yet
+    bool  freeAlive;
+
+    // Rows of ages 1..settledAge after a long stretch of open air
+    int   settledAge;
+    std::vector<std::uint64_t> settled;
+    std::vector<int>   settledFirst, settledLast;
+    std::vector<Segment> segments;
+    std::unordered_map<EpisodeKey, bool, EpisodeHash> episodes;
+
+    // Lower bound kept while pinEpisode runs the upper one
+    std::vector<std::uint64_t> pinnedRows;
+    std::vector<int>   pinnedOrder, pinnedFirst, pinnedLast;
+
+    void bandBins(float lo, float hi, int& bLo, int& bHi) const;
+    void advance(int bLo, int bHi);
+    void captureSettled();
+    void loadSettled();
+    bool holdsSettled() const;
+    void loadFull();
+    bool pinEpisode(const Segment& a, const Segment& b);
+
+    std::uint64_t* row(int t) { return rows.data() + static_cast<std::size_t>(t & ringMask) * stride + 1; }
+};
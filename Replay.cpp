@@ -0,0 +1,184 @@
+#include "Replay.h"
+#include <fstream>
+#include <memory>
+
+// ─── Varint (LEB128) ──────────────────────────────────────────────────────
+static void putVarint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+static bool getVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) return false;
+        std::uint8_t b = *p++;
+        v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+// ─── Recording ────────────────────────────────────────────────────────────
+void Replay::begin(std::uint64_t runSeed, Difficulty d, HitboxMode mode, GapLayout gaps,
+                   std::uint32_t rate, std::uint32_t w, std::uint32_t h) {
+    seed       = runSeed;
+    difficulty = d;
+    hitbox     = mode;
+    layout     = gaps;
+    physics    = SIM_PHYSICS;
+    tickRate   = rate;
+    width      = w;
+    height     = h;
+    tickCount  = 0;
+    score      = 0;
+    flapTicks.clear();
+}
+
+void Replay::addFlap(std::uint32_t tick) {
+    // Several inputs inside one tick collapse into a single flap
+    if (!flapTicks.empty() && flapTicks.back() == tick) return;
+    flapTicks.push_back(tick);
+}
+
+// ─── Encoding ─────────────────────────────────────────────────────────────
+std::vector<std::uint8_t> Replay::encode() const {
+    std::vector<std::uint8_t> out = { 'F', 'B', 'R', VERSION };
+    out.reserve(16 + flapTicks.size());
+    out.push_back(static_cast<std::uint8_t>(difficulty));
+    out.push_back(static_cast<std::uint8_t>(hitbox));
+    out.push_back(static_cast<std::uint8_t>(layout));
+    out.push_back(static_cast<std::uint8_t>(physics));
+    putVarint(out, tickRate);
+    putVarint(out, width);
+    putVarint(out, height);
+    putVarint(out, seed);
+    putVarint(out, tickCount);
+    putVarint(out, score);
+    putVarint(out, flapTicks.size());
+    std::uint32_t prev = 0;
+    for (std::uint32_t t : flapTicks) {
+        putVarint(out, t - prev);
+        prev = t;
+    }
+    return out;
+}
+
+bool Replay::validBounds(Difficulty d, std::uint64_t w, std::uint64_t h) {
+    if (w < 1 || w > MAX_BOUND || h > MAX_BOUND) return false;
+    // Same range as SimWorld::getGapMinY() / getGapMaxY() at the base gap,
+    // the widest the ramp ever has
+    return static_cast<float>(h) - SimWorld::GROUND_H - DifficultyParams::forLevel(d).pipeGap * 0.5f
+           >= SimWorld::getGapMinY();
+}
+
+bool Replay::decode(const std::uint8_t* p, std::size_t size) {
+    const std::uint8_t* end = p + size;
+    if (size < 6 || p[0] != 'F' || p[1] != 'B' || p[2] != 'R') return false;
+    if (p[3] != VERSION && p[3] != VERSION_NO_PHYSICS && p[3] != VERSION_NO_LAYOUT) return false;
+    const bool hasLayout  = p[3] != VERSION_NO_LAYOUT;
+    const bool hasPhysics = p[3] == VERSION;
+    p += 4;
+    if (*p > static_cast<std::uint8_t>(Difficulty::HARD)) return false;
+    difficulty = static_cast<Difficulty>(*p++);
+    if (*p > static_cast<std::uint8_t>(HitboxMode::HULL)) return false;
+    hitbox = static_cast<HitboxMode>(*p++);
+    layout = GapLayout::UNIFORM;
+    if (hasLayout) {
+        if (p == end || *p > static_cast<std::uint8_t>(GapLayout::FAIR)) return false;
+        layout = static_cast<GapLayout>(*p++);
+    }
+    physics = SimPhysics::FLOAT;
+    if (hasPhysics) {
+        if (p == end || *p > static_cast<std::uint8_t>(SimPhysics::FIXED)) return false;
+        physics = static_cast<SimPhysics>(*p++);
+    }
+
+    std::uint64_t rate, w, h, s, ticks, sc, n;
+    if (!getVarint(p, end, rate) || !getVarint(p, end, w)     || !getVarint(p, end, h) ||
+        !getVarint(p, end, s)    || !getVarint(p, end, ticks) || !getVarint(p, end, sc) ||
+        !getVarint(p, end, n)) return false;
+    if (rate == 0 || rate > MAX_TICK_RATE) return false;
+    if (!validBounds(difficulty, w, h)) return false;
+    if (n > static_cast<std::uint64_t>(end - p)) return false;   // one byte per flap minimum
+    tickRate  = static_cast<std::uint32_t>(rate);
+    width     = static_cast<std::uint32_t>(w);
+    height    = static_cast<std::uint32_t>(h);
+    seed      = s;
+    tickCount = static_cast<std::uint32_t>(ticks);
+    score     = static_cast<std::uint32_t>(sc);
+
+    flapTicks.clear();
+    flapTicks.reserve(static_cast<std::size_t>(n));
+    std::uint64_t t = 0;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        std::uint64_t d;
+        if (!getVarint(p, end, d)) return false;
+        t += d;
+        flapTicks.push_back(static_cast<std::uint32_t>(t));
+    }
+    return p == end;
+}
+
+bool Replay::save(const std::string& path) const {
+    std::ofstream f(path, std::ios::binary);
+    if (!f.is_open()) return false;
+    std::vector<std::uint8_t> bytes = encode();
+    f.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(f);
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f.is_open()) return false;
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(f)),
+                                     std::istreambuf_iterator<char>());
+    return decode(bytes.data(), bytes.size());
+}
+
+// ─── Playback ─────────────────────────────────────────────────────────────
+bool ReplayPlayer::apply(SimWorld& world) {
+    if (!replay) return false;
+    bool flapped = false;
+    const auto& ticks = replay->flapTicks;
+    while (cursor < ticks.size() && ticks[cursor] <= world.getTick()) {
+        if (ticks[cursor] == world.getTick() && !world.getBird().isDead()) {
+            world.flap();
+            flapped = true;
+        }
+        ++cursor;
+    }
+    return flapped;
+}
+
+ReplayResult simulateReplay(const Replay& r, bool hashStates) {
+    SimWorld world(static_cast<float>(r.width), static_cast<float>(r.height));
+    world.setDifficulty(DifficultyParams::forLevel(r.difficulty));
+    world.setHitboxMode(r.hitbox);
+    const float dt = 1.f / static_cast<float>(r.tickRate);
+    std::unique_ptr<GapPlanner> planner;
+    if (r.layout == GapLayout::FAIR) {
+        planner.reset(new GapPlanner());
+        planner->setParams(FairGapParams::forLevel(r.difficulty));
+        planner->setStep(dt);
+        world.setGapSource(planner.get());
+    }
+    world.reset(r.seed);
+
+    ReplayPlayer player;
+    player.start(r);
+    // A bird that stops flapping lands within a few seconds, so no run
+    // outlasts 10 s per stored flap. The cap grows with the flaps actually
+    // in the file (at least a byte each), never with the header's claims.
+    const std::uint64_t limit = (static_cast<std::uint64_t>(r.flapTicks.size()) + 1) * 10ull * r.tickRate;
+    std::uint64_t hash = 0;
+    while (!world.isOver() && world.getTick() < limit) {
+        player.apply(world);
+        world.step(dt, r.physics);
+        if (hashStates) hash = (hash ^ world.stateHash()) * 1099511628211ull;
+    }
+    return ReplayResult{ world.getScore(), world.getTick(), hash };
+}
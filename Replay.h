@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "SimWorld.h"
+#include "FairGaps.h"
+
+// ─── Input replay ─────────────────────────────────────────────────────────
+// A run is fully determined by its seed, difficulty, hitbox mode, gap
+// layout, physics, tick rate, world bounds and the ticks on which the
+// player flapped, so that is all a replay stores.
+//
+// File layout (.fbr):
+//   "FBR" + version byte
+//   difficulty (1 byte), hitbox mode (1 byte), gap layout (1 byte, v5+),
+//   physics (1 byte, v6+: SimPhysics the recording build stepped with)
+//   varint tickRate, width, height, seed, tickCount, score, flapCount
+//   flapCount varints: delta from the previous flap tick (first: from 0)
+// A typical 100-point run is a few hundred one-byte deltas.
+
+struct Replay {
+    static const std::uint8_t VERSION = 6;   // bumped whenever the rules change outcomes
+    static const std::uint8_t VERSION_NO_PHYSICS = 5;  // still read: float physics
+    static const std::uint8_t VERSION_NO_LAYOUT = 4;   // still read: uniform gaps, float physics
+    static const std::uint32_t MAX_TICK_RATE = 1000;    // Hz; anything above is refused as forged
+    static const std::uint32_t MAX_BOUND = 16384;       // px, either world side
+
+    std::uint64_t seed       = 0;
+    Difficulty    difficulty = Difficulty::NORMAL;
+    HitboxMode    hitbox     = HitboxMode::BOX;
+    GapLayout     layout     = GapLayout::UNIFORM;
+    SimPhysics    physics    = SIM_PHYSICS;
+    std::uint32_t tickRate   = 120;
+    std::uint32_t width      = 600;   // world bounds: pipe range and ground depend on them
+    std::uint32_t height     = 800;
+    std::uint32_t tickCount  = 0;   // ticks until the bird landed
+    std::uint32_t score      = 0;   // score claimed by the recording client
+    std::vector<std::uint32_t> flapTicks;   // world tick index before the flap's step
+
+    // Fixed physics with nothing float deciding the run: the hull test and
+    // the fair planner still run in float, so only BOX + uniform replays
+    // re-simulate bit-for-bit on every build
+    bool isBitExact() const {
+        return physics == SimPhysics::FIXED && hitbox == HitboxMode::BOX && layout == GapLayout::UNIFORM;
+    }
+
+    // World bounds a run can be recorded and verified in: up to MAX_BOUND,
+    // and tall enough that the gap range above the ground is not empty
+    static bool validBounds(Difficulty d, std::uint64_t w, std::uint64_t h);
+
+    void begin(std::uint64_t runSeed, Difficulty d, HitboxMode mode, GapLayout gaps, std::uint32_t rate,
+               std::uint32_t w, std::uint32_t h);
+    void addFlap(std::uint32_t tick);
+
+    std::vector<std::uint8_t> encode() const;
+    bool decode(const std::uint8_t* data, std::size_t size);
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+// Outcome of re-running a replay through the rules without a window.
+// `hash` chains SimWorld::stateHash() over every tick when asked for, so
+// two builds agree on it only if they agree on every tick.
+struct ReplayResult {
+    int           score;
+    std::uint32_t ticks;
+    std::uint64_t hash;
+    bool matches(const Replay& r) const {
+        return score == static_cast<int>(r.score) && ticks == r.tickCount;
+    }
+};
+
+// Headless re-simulation at the replay's own tick rate and physics
+ReplayResult simulateReplay(const Replay& r, bool hashStates = false);
+
+// Feeds recorded flaps back into a world, one tick at a time
+class ReplayPlayer {
+public:
+    void start(const Replay& r) { replay = &r; cursor = 0; }
+    bool isActive() const { return replay != nullptr; }
+    void stop() { replay = nullptr; }
+
+    // Call before each SimWorld::step(); returns true if the bird flapped
+    bool apply(SimWorld& world);
+
+private:
+    const Replay* replay = nullptr;
+    std::size_t   cursor = 0;
+};
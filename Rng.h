@@ -0,0 +1,59 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// ─── PCG32 random generator ───────────────────────────────────────────────
+// Small, fast and explicitly seeded. Every world / game owns its own
+// instances, so runs are reproducible and can be stepped on any thread.
+// The stream id selects an independent sequence for the same seed.
+
+enum RngStream : std::uint64_t {
+    RNG_STREAM_GAMEPLAY = 1,   // pipe layout: decides the course
+    RNG_STREAM_COSMETIC = 2,   // clouds, stars, mountains, background birds
+    RNG_STREAM_EVOLUTION = 3   // trainer: initial weights, selection, mutation
+};
+
+class Rng {
+public:
+    explicit Rng(std::uint64_t seedValue = 0, std::uint64_t stream = RNG_STREAM_GAMEPLAY) {
+        seed(seedValue, stream);
+    }
+
+    void seed(std::uint64_t seedValue, std::uint64_t stream) {
+        state = 0u;
+        inc   = (stream << 1u) | 1u;
+        nextU32();
+        state += seedValue;
+        nextU32();
+    }
+
+    std::uint32_t nextU32() {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+        std::uint32_t rot        = static_cast<std::uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }
+
+    // Uniform float in [0, 1) with 24 bits of precision
+    float uniform() { return static_cast<float>(nextU32() >> 8) * (1.f / 16777216.f); }
+    float uniform(float lo, float hi) { return lo + uniform() * (hi - lo); }
+
+    // Standard normal draw (Box-Muller, one of the pair)
+    float gaussian() {
+        const float u1 = std::max(uniform(), 1e-7f);
+        const float u2 = uniform();
+        return std::sqrt(-2.f * std::log(u1)) * std::cos(6.2831853f * u2);
+    }
+
+    // Uniform integer in [0, n) (multiply-shift, no division)
+    int below(int n) {
+        return static_cast<int>((static_cast<std::uint64_t>(nextU32()) *
+                                 static_cast<std::uint32_t>(n)) >> 32);
+    }
+
+private:
+    std::uint64_t state;
+    std::uint64_t inc;
+};
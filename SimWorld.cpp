@@ -0,0 +1,422 @@
+#include "SimWorld.h"
+#include "Collision.h"
+#include "BirdHull.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// ─── SimBird ──────────────────────────────────────────────────────────────
+SimBird::SimBird(float x, float y)
+    : x(x), y(y), velocity(0.f), gravity(1500.f), flapStrength(-520.f),
+      rotation(0.f), state(BirdState::IDLE), wingState(WingState::NEUTRAL),
+      wingTimer(0.f), wingAnimSpeed(0.08f), celebrateTimer(0.f), celebrateBounce(0.f)
+{
+}
+
+// ─── FIX: flap now always works unless bird is DEAD ──────────────────────
+void SimBird::flap() {
+    if (state != BirdState::DEAD) {
+        // Cancel any ongoing celebration immediately
+        if (state == BirdState::CELEBRATING) {
+            celebrateTimer = 999.f; // force celebration to end
+        }
+        velocity    = flapStrength;
+        state       = BirdState::FLAPPING;
+        wingTimer   = 0.f;
+        wingState   = WingState::UP;
+    }
+}
+
+// ─── FIX: celebrate is now a SHORT visual-only effect (0.5s) ─────────────
+void SimBird::celebrate() {
+    if (state == BirdState::DEAD) return;
+    state          = BirdState::CELEBRATING;
+    celebrateTimer = 0.f;
+    // Do NOT change velocity — bird keeps flying normally
+}
+
+void SimBird::die() {
+    state     = BirdState::DEAD;
+    wingState = WingState::DOWN;
+}
+
+// Public wing animation for menu idle animation
+void SimBird::animateWing(float dt) {
+    wingTimer += dt;
+    if (wingTimer > 0.2f) {
+        wingTimer = 0.f;
+        int next = (static_cast<int>(wingState) + 1) % 3;
+        wingState = static_cast<WingState>(next);
+    }
+}
+
+// One tick of gravity. Under Fixed the fresh velocity moves the bird at
+// full precision and is then stored rounded, just as float stores it.
+template <class Real>
+void SimBird::fall(float dt) {
+    const Real v = Real(velocity) + Real(gravity) * Real(dt);
+    velocity = float(v);
+    y        = float(Real(y) + v * Real(dt));
+}
+
+template <class Real>
+void SimBird::update(float dt) {
+    updateState(dt);
+    updateWingAnimation(dt);
+
+    if (state == BirdState::CELEBRATING) {
+        celebrateTimer += dt;
+        celebrateBounce = std::sin(celebrateTimer * 10.f) * 4.f;
+
+        // ─── FIX: normal physics during celebration ───────────────────
+        fall<Real>(dt);
+
+        // Gentle wobble rotation
+        rotation = std::sin(celebrateTimer * 6.f) * 10.f;
+
+        // Auto-end celebration after 0.5 seconds → return to normal flight
+        if (celebrateTimer >= 0.5f) {
+            state    = BirdState::GLIDING;
+            rotation = 0.f;
+        }
+    } else if (state == BirdState::DEAD) {
+        fall<Real>(dt);
+        rotation += 280.f * dt;
+        if (rotation > 90.f) rotation = 90.f;
+    } else {
+        fall<Real>(dt);
+
+        float targetRot = velocity * 0.05f;
+        if (targetRot < -30.f) targetRot = -30.f;
+        if (targetRot >  90.f) targetRot =  90.f;
+
+        float rotSpeed = (state == BirdState::FLAPPING) ? 20.f : 8.f;
+        rotation += (targetRot - rotation) * rotSpeed * dt;
+    }
+}
+
+template void SimBird::update<float>(float);
+template void SimBird::update<Fixed>(float);
+
+void SimBird::updateState(float dt) {
+    // ─── FIX: allow state transitions out of CELEBRATING ─────────────
+    if (state == BirdState::DEAD) return;
+    if (state == BirdState::CELEBRATING) return; // handled in update()
+
+    if (state == BirdState::FLAPPING) {
+        wingTimer += dt;
+        if (wingTimer > 0.15f) state = BirdState::GLIDING;
+    } else if (state == BirdState::GLIDING) {
+        if (velocity > 100.f) state = BirdState::FALLING;
+    } else if (state == BirdState::FALLING) {
+        if (velocity < 0.f) state = BirdState::GLIDING;
+    }
+}
+
+void SimBird::updateWingAnimation(float dt) {
+    wingTimer += dt;
+
+    if (state == BirdState::CELEBRATING) {
+        if (wingTimer > wingAnimSpeed * 0.5f) {
+            wingTimer = 0.f;
+            wingState = (wingState == WingState::UP) ? WingState::DOWN : WingState::UP;
+        }
+    } else if (state == BirdState::FLAPPING) {
+        if      (wingTimer < 0.05f) wingState = WingState::UP;
+        else if (wingTimer < 0.10f) wingState = WingState::MID;
+        else                        wingState = WingState::DOWN;
+    } else if (state == BirdState::GLIDING) {
+        wingState = WingState::NEUTRAL;
+    } else if (state == BirdState::FALLING) {
+        if (wingTimer > wingAnimSpeed * 2.f) wingTimer = 0.f;
+        wingState = (wingTimer < wingAnimSpeed) ? WingState::MID : WingState::NEUTRAL;
+    } else if (state == BirdState::DEAD) {
+        wingState = WingState::DOWN;
+    }
+}
+
+void SimBird::reset(float x, float y) {
+    this->x        = x;
+    this->y        = y;
+    velocity       = 0.f;
+    rotation       = 0.f;
+    state          = BirdState::IDLE;
+    wingState      = WingState::NEUTRAL;
+    wingTimer      = 0.f;
+    celebrateTimer = 0.f;
+    celebrateBounce= 0.f;
+}
+
+// ─── Difficulty ───────────────────────────────────────────────────────────
+DifficultyParams DifficultyParams::forLevel(Difficulty d) {
+    switch (d) {
+        case Difficulty::EASY:   return DifficultyParams{ 120.f, 220.f, 3.0f };
+        case Difficulty::HARD:   return DifficultyParams{ 210.f, 145.f, 2.0f };
+        case Difficulty::NORMAL:
+        default:                 return DifficultyParams{ 160.f, 185.f, 2.4f };
+    }
+}
+
+void DifficultyParams::ramp() {
+    pipeSpeed     = std::min(pipeSpeed + 5.f, 320.f);
+    pipeGap       = std::max(pipeGap   - 3.f, 110.f);
+    spawnInterval = std::max(spawnInterval - 0.05f, 1.5f);
+}
+
+// ─── SimWorld ─────────────────────────────────────────────────────────────
+SimWorld::SimWorld(float width, float height, std::uint64_t seed)
+    : width(width), height(height),
+      bird(BIRD_START_X, BIRD_START_Y),
+      rng(seed, RNG_STREAM_GAMEPLAY),
+      baseDifficulty(DifficultyParams::forLevel(Difficulty::NORMAL)),
+      difficulty(baseDifficulty),
+      hitbox(HitboxMode::BOX), gapSource(nullptr),
+      pipeSpawnTimer(0.f), spawned(0), score(0), over(false), tick(0)
+{
+    resizePipes();
+}
+
+void SimWorld::setBounds(float w, float h) {
+    width  = w;
+    height = h;
+    resizePipes();
+}
+
+void SimWorld::setDifficulty(const DifficultyParams& d) {
+    baseDifficulty = d;
+    difficulty     = d;
+    resizePipes();
+}
+
+int SimWorld::pipeCapacityFor(float width, const DifficultyParams& d) {
+    // Consecutive pipes are at least speed * interval apart. A ramp between
+    // two spawns can pair the old speed with the new, shorter interval, so
+    // take the minimum over speed[k] * interval[k+1] across the whole ramp.
+    DifficultyParams cur = d;
+    float minSpacing = cur.pipeSpeed * cur.spawnInterval;
+    for (int k = 0; k < 100; ++k) {
+        DifficultyParams next = cur;
+        next.ramp();
+        minSpacing = std::min(minSpacing, cur.pipeSpeed * next.spawnInterval);
+        if (next.pipeSpeed == cur.pipeSpeed && next.spawnInterval == cur.spawnInterval) break;
+        cur = next;
+    }
+    // A pipe lives from x = width + 20 until its right edge passes x = 0
+    float travel = width + 20.f + PIPE_WIDTH;
+    return static_cast<int>(travel / minSpacing) + 2;
+}
+
+void SimWorld::resizePipes() {
+    pipes.setCapacity(pipeCapacityFor(width, baseDifficulty));
+}
+
+void SimWorld::reset() {
+    bird.reset(BIRD_START_X, BIRD_START_Y);
+    pipes.clear();
+    difficulty     = baseDifficulty;
+    pipeSpawnTimer = 0.f;
+    spawned        = 0;
+    score          = 0;
+    over           = false;
+    tick           = 0;
+    // The source gets its own seed from this stream, so reset(seed) fixes
+    // a fair course just as it fixes a uniform one
+    if (gapSource) {
+        std::uint64_t hi = rng.nextU32();
+        gapSource->restart(*this, (hi << 32) | rng.nextU32());
+    }
+}
+
+void SimWorld::reset(std::uint64_t seed) {
+    rng.seed(seed, RNG_STREAM_GAMEPLAY);
+    reset();
+}
+
+// ─── Snapshots ────────────────────────────────────────────────────────────
+void SimWorld::observe(float* out) const {
+    const float left = bird.getBounds().left;
+    out[SIM_OBS_Y]        = bird.y;
+    out[SIM_OBS_VELOCITY] = bird.velocity;
+    out[SIM_OBS_PIPE_X]   = width + 20.f;
+    out[SIM_OBS_PIPE_TOP] = 0.f;
+    out[SIM_OBS_PIPE_BOT] = getGroundY();
+    for (int i = 0; i < pipes.size(); ++i) {
+        if (pipeRight(pipes[i].x) <= left) continue;
+        out[SIM_OBS_PIPE_X]   = pipes[i].x;
+        out[SIM_OBS_PIPE_TOP] = pipes[i].topY;
+        out[SIM_OBS_PIPE_BOT] = pipes[i].botY;
+        break;
+    }
+}
+
+// FNV-style fold over 32-bit words: floats by bit pattern, so any
+// difference in the last place shows
+std::uint64_t SimWorld::stateHash() const {
+    std::uint64_t h = 14695981039346656037ull;
+    auto word = [&h](std::uint32_t w) { h = (h ^ w) * 1099511628211ull; };
+    auto real = [&word](float f) { std::uint32_t w; std::memcpy(&w, &f, 4); word(w); };
+    word(tick);
+    word(static_cast<std::uint32_t>(score));
+    word(static_cast<std::uint32_t>(spawned));
+    word((over ? 1u : 0u) | (static_cast<std::uint32_t>(bird.state) << 1));
+    real(bird.y);
+    real(bird.velocity);
+    real(pipeSpawnTimer);
+    real(difficulty.pipeSpeed);
+    // Rotation is float in either mode; it only decides the run under HULL
+    if (hitbox == HitboxMode::HULL) real(bird.rotation);
+    for (int i = 0; i < pipes.size(); ++i) {
+        real(pipes[i].x);
+        real(pipes[i].topY);
+        real(pipes[i].botY);
+        word(pipes[i].passed ? 1u : 0u);
+    }
+    return h;
+}
+
+void SimWorld::save(SimSnapshot& out) const {
+    out.width          = width;
+    out.height         = height;
+    out.bird           = bird;
+    out.pipes          = pipes;
+    out.rng            = rng;
+    out.baseDifficulty = baseDifficulty;
+    out.difficulty     = difficulty;
+    out.hitbox         = hitbox;
+    out.gapSource      = gapSource;
+    out.pipeSpawnTimer = pipeSpawnTimer;
+    out.spawned        = spawned;
+    out.score          = score;
+    out.over           = over;
+    out.tick           = tick;
+}
+
+void SimWorld::restore(const SimSnapshot& in) {
+    width          = in.width;
+    height         = in.height;
+    bird           = in.bird;
+    pipes          = in.pipes;
+    rng            = in.rng;
+    baseDifficulty = in.baseDifficulty;
+    difficulty     = in.difficulty;
+    hitbox         = in.hitbox;
+    gapSource      = in.gapSource;
+    pipeSpawnTimer = in.pipeSpawnTimer;
+    spawned        = in.spawned;
+    score          = in.score;
+    over           = in.over;
+    tick           = in.tick;
+}
+
+// Menu idle: wings flap in place, no physics
+void SimWorld::idle(float dt) {
+    bird.update(dt * 0.f);
+    bird.animateWing(dt);
+}
+
+// Same expressions as Rng::uniform(lo, hi) and getGapMaxY(), in Real
+template <class Real>
+void SimWorld::spawnPipe() {
+    if (pipes.full()) return;   // only on windows wider than SIM_MAX_PIPES allows
+    const Real lo = Real(getGapMinY());
+    const Real hi = Real(height) - Real(GROUND_H) - Real(difficulty.pipeGap) * Real(0.5f);
+    Real gapY = gapSource ? Real(gapSource->gapCentre(spawned))
+                          : lo + Real(rng.uniform()) * (hi - lo);
+    Real half = Real(difficulty.pipeGap) / Real(2.f);
+    ++spawned;
+    pipes.push_back(SimPipe{ float(Real(width) + Real(20.f)), float(gapY - half), float(gapY + half), false });
+}
+
+// Overlap at the end of the step, or anywhere along the step's relative
+// motion, so a long step cannot carry the bird through a cap corner. The
+// hull SAT and its rotation tables are float in either mode.
+template <class Real>
+bool SimWorld::checkCollision(const SimPipe& p, const BasicSimRect<Real>& bb, Real sweepX, Real sweepY) const {
+    if (hitbox == HitboxMode::HULL)
+        return hullHitsPipe(bird.x, bird.y, bird.rotation, float(sweepX), float(sweepY),
+                            pipeRects(p.x, p.topY, p.botY, getGroundY()));
+    const BasicPipeRects<Real> r = pipeRects(Real(p.x), Real(p.topY), Real(p.botY), Real(height) - Real(GROUND_H));
+    return boxHitsPipe(bb, r) || sweptHitsPipe(bb, Real(1.f) / sweepX, Real(1.f) / sweepY, r);
+}
+
+template <class Real>
+unsigned SimWorld::step(float dt) {
+    ++tick;
+    const Real prevY = Real(bird.y);
+    bird.update<Real>(dt);
+    unsigned events = advancePipes<Real>(dt);
+
+    // Broadphase: pipes are ordered by x, so only the ones overlapping the
+    // bird's x-span over this step (it sweeps right by the scroll distance
+    // in the pipes' frame) are tested, and the scan stops at the first pipe
+    // entirely to its right. A pixel of slack keeps the cull from ever
+    // deciding a boundary case, so it never changes the outcome.
+    const BasicSimRect<Real> bb = bird.boundsAs<Real>();
+    const Real sweepX = Real(difficulty.pipeSpeed) * Real(dt);
+    const Real sweepY = Real(bird.y) - prevY;
+    Real spanL = bb.left - sweepX - Real(1.f);
+    Real spanR = bb.left + bb.width + Real(1.f);
+    if (hitbox == HitboxMode::HULL) {
+        const Real reach = Real(BirdHull::instance().getReach());
+        spanL = Real(bird.x) - reach - sweepX - Real(1.f);
+        spanR = Real(bird.x) + reach + Real(1.f);
+    }
+    for (int i = 0; i < pipes.size() && !bird.isDead(); ++i) {
+        const SimPipe& p = pipes[i];
+        if (pipeLeft(Real(p.x)) >= spanR) break;
+        if (pipeRight(Real(p.x)) <= spanL) continue;
+        if (checkCollision(p, bb, sweepX, sweepY)) {
+            bird.die(); events |= SIM_DIED;
+        }
+    }
+    if (Real(bird.y) < Real(0.f) && !bird.isDead()) {
+        bird.die(); events |= SIM_DIED;
+    }
+    if (Real(bird.y) >= Real(height) - Real(GROUND_H)) {
+        if (!bird.isDead()) { bird.die(); events |= SIM_DIED; }
+        over    = true;
+        events |= SIM_GROUNDED;
+    }
+    return events;
+}
+
+template <class Real>
+unsigned SimWorld::stepCourse(float dt) {
+    ++tick;
+    return advancePipes<Real>(dt);
+}
+
+// Spawn, scroll, score (with the ramp) and retire pipes
+template <class Real>
+unsigned SimWorld::advancePipes(float dt) {
+    unsigned events = SIM_NONE;
+    pipeSpawnTimer = float(Real(pipeSpawnTimer) + Real(dt));
+    if (Real(pipeSpawnTimer) >= Real(difficulty.spawnInterval)) {
+        pipeSpawnTimer = 0.f;
+        spawnPipe<Real>();
+    }
+
+    for (int i = 0; i < pipes.size(); ++i) {
+        SimPipe& p = pipes[i];
+        p.x = float(Real(p.x) - Real(difficulty.pipeSpeed) * Real(dt));
+        if (!p.passed && Real(p.x) + Real(PIPE_WIDTH) < Real(bird.x)) {
+            p.passed = true;
+            score++;
+            events |= SIM_SCORED;
+
+            if (score % 10 == 0) difficulty.ramp();
+            // celebrate is now visual-only — does NOT block input
+            if (score % 5 == 0) bird.celebrate();
+        }
+    }
+
+    // All pipes share one speed, so only the front can have left the screen
+    while (!pipes.empty() && Real(pipes.front().x) + Real(PIPE_WIDTH) < Real(0.f))
+        pipes.pop_front();
+    return events;
+}
+
+template unsigned SimWorld::step<float>(float);
+template unsigned SimWorld::step<Fixed>(float);
+template unsigned SimWorld::stepCourse<float>(float);
+template unsigned SimWorld::stepCourse<Fixed>(float);
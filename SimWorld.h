@@ -0,0 +1,303 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "Rng.h"
+#include "Fixed.h"
+
+// ─── Window-free gameplay rules ───────────────────────────────────────────
+// Everything that decides the outcome of a run lives here: bird physics,
+// pipe spawning, scoring, the difficulty ramp and the death checks.
+// No SFML dependency, so headless tools and the windowed Game step exactly
+// the same rules.
+
+// Arithmetic for bird and pipe motion, the spawn timer, the gap draw and
+// the BOX test. float is the game as it always played; Fixed (Fixed.h)
+// gives bit-identical ticks on every compiler and flag set, which is what
+// lets a replay verify on any build. State is stored as float either way;
+// under Fixed each stored value comes out of integer math and one exact
+// conversion. -DFLAPPY_FIXED_PHYSICS makes Fixed the default for the
+// whole build, and either can still be asked for by template argument.
+// The HULL test, the bird's rotation and GapPlanner stay float, so only
+// BOX runs with uniform gaps are bit-identical everywhere.
+enum class SimPhysics : std::uint8_t { FLOAT, FIXED };
+#if defined(FLAPPY_FIXED_PHYSICS)
+using SimReal = Fixed;
+static constexpr SimPhysics SIM_PHYSICS = SimPhysics::FIXED;
+#else
+using SimReal = float;
+static constexpr SimPhysics SIM_PHYSICS = SimPhysics::FLOAT;
+#endif
+
+enum class BirdState {
+    IDLE,
+    FLAPPING,
+    GLIDING,
+    FALLING,
+    DEAD,
+    CELEBRATING
+};
+
+enum class WingState {
+    UP,
+    MID,
+    DOWN,
+    NEUTRAL
+};
+
+template <class Real>
+struct BasicSimRect {
+    Real left, top, width, height;
+
+    bool intersects(const BasicSimRect& o) const {
+        return left < o.left + o.width  && o.left < left + width &&
+               top  < o.top  + o.height && o.top  < top  + height;
+    }
+};
+using SimRect = BasicSimRect<float>;
+
+// Bird physics and animation state (formerly the non-visual half of Bird)
+struct SimBird {
+    float x, y;
+    float velocity;
+    float gravity;
+    float flapStrength;
+    float rotation;
+
+    BirdState state;
+    WingState wingState;
+    float wingTimer;
+    float wingAnimSpeed;
+    float celebrateTimer;
+    float celebrateBounce;
+
+    SimBird(float x = 0.f, float y = 0.f);
+
+    template <class Real = SimReal> void update(float dt);
+    void flap();
+    void reset(float x, float y);
+    void celebrate();
+    void die();
+    void animateWing(float dt);
+
+    SimRect getBounds() const { return boundsAs<float>(); }
+    template <class Real> BasicSimRect<Real> boundsAs() const {
+        return BasicSimRect<Real>{ Real(x) - Real(22.f), Real(y) - Real(18.f), Real(44.f), Real(36.f) };
+    }
+    bool isDead() const { return state == BirdState::DEAD; }
+    bool isCelebrating() const { return state == BirdState::CELEBRATING; }
+
+private:
+    template <class Real> void fall(float dt);
+    void updateWingAnimation(float dt);
+    void updateState(float dt);
+};
+
+enum class Difficulty { EASY, NORMAL, HARD };
+
+// BOX is the original fixed 44x36 rect. HULL tests the convex body, head
+// and beak the bird is drawn with, rotated with the bird (see BirdHull.h),
+// so a nose-dive at 90° collides with what is on screen.
+enum class HitboxMode { BOX, HULL };
+
+// Pipe speed / gap / spawn interval for one world. Each world owns a copy
+// (no shared statics), so worlds with different settings can run side by
+// side on different threads.
+struct DifficultyParams {
+    float pipeSpeed;
+    float pipeGap;
+    float spawnInterval;
+
+    static DifficultyParams forLevel(Difficulty d);
+
+    // Every 10 points: faster, narrower, denser — up to the caps
+    void ramp();
+};
+
+// Gap edges are captured at spawn, so a later ramp never reshapes a pipe
+// that is already on screen.
+struct SimPipe {
+    float x;
+    float topY;    // bottom edge of the top pipe
+    float botY;    // top edge of the bottom pipe
+    bool  passed;
+};
+
+// Bit flags returned by SimWorld::step()
+enum SimEvent : unsigned {
+    SIM_NONE     = 0,
+    SIM_SCORED   = 1u << 0,  // bird cleared a pipe
+    SIM_DIED     = 1u << 1,  // bird hit a pipe or the ceiling this tick
+    SIM_GROUNDED = 1u << 2   // bird reached the ground: run is over
+};
+
+// Maximum pipes alive at once. Spawns are at least ~340 px apart, so 16
+// covers a window about 5000 px wide. Must stay a power of two.
+static constexpr int SIM_MAX_PIPES = 16;
+static_assert((SIM_MAX_PIPES & (SIM_MAX_PIPES - 1)) == 0, "SIM_MAX_PIPES must be a power of two");
+
+// Pipes spawn on the right and leave on the left in the same order, so they
+// live in a fixed ring: push at the back, pop at the front, nothing moves
+// and nothing is allocated. The usable capacity is sized per world from
+// its width and difficulty (see SimWorld::pipeCapacityFor).
+class PipeRing {
+public:
+    PipeRing() : head(0), count(0), cap(SIM_MAX_PIPES) {}
+
+    int  size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count >= cap; }
+    int  capacity() const { return cap; }
+    void setCapacity(int c) { cap = c < SIM_MAX_PIPES ? c : SIM_MAX_PIPES; }
+
+    // Index 0 is the oldest (leftmost) pipe
+    SimPipe&       operator[](int i)       { return slots[(head + i) & (SIM_MAX_PIPES - 1)]; }
+    const SimPipe& operator[](int i) const { return slots[(head + i) & (SIM_MAX_PIPES - 1)]; }
+    SimPipe&       front()       { return slots[head]; }
+    const SimPipe& front() const { return slots[head]; }
+
+    void push_back(const SimPipe& p) {
+        slots[(head + count) & (SIM_MAX_PIPES - 1)] = p;
+        ++count;
+    }
+    void pop_front() {
+        head = (head + 1) & (SIM_MAX_PIPES - 1);
+        --count;
+    }
+    void clear() { head = 0; count = 0; }
+
+private:
+    SimPipe slots[SIM_MAX_PIPES];
+    int head;
+    int count;
+    int cap;
+};
+
+class SimWorld;
+
+// Chooses gap centres in place of the world's uniform draw (see FairGaps.h).
+// Pipe `index` is the index-th spawn since the last reset; the same index
+// must always give the same centre, so snapshots replay the same course.
+class GapSource {
+public:
+    virtual ~GapSource() = default;
+    // Called by SimWorld::reset() once the world's rules are set
+    virtual void  restart(const SimWorld& world, std::uint64_t seed) = 0;
+    virtual float gapCentre(int index) = 0;
+};
+
+// Observation layout written by SimWorld::observe(), in world pixels
+enum SimObs {
+    SIM_OBS_Y,
+    SIM_OBS_VELOCITY,
+    SIM_OBS_PIPE_X,      // nearest pipe the bird has not flown past (width + 20 if none)
+    SIM_OBS_PIPE_TOP,    // its gap edges (0 and ground if none)
+    SIM_OBS_PIPE_BOT,
+    SIM_OBS_SIZE
+};
+
+// Complete state of a world, held by value: saving or restoring one never
+// touches the heap, so a run can be branched thousands of times per frame.
+struct SimSnapshot {
+    float    width, height;
+    SimBird  bird;
+    PipeRing pipes;
+    Rng      rng;
+    DifficultyParams baseDifficulty;
+    DifficultyParams difficulty;
+    HitboxMode hitbox;
+    GapSource* gapSource;
+    float   pipeSpawnTimer;
+    int     spawned;
+    int     score;
+    bool    over;
+    std::uint32_t tick;
+};
+static_assert(std::is_trivially_copyable<SimSnapshot>::value, "SimSnapshot must stay memcpy-able");
+
+class SimWorld {
+public:
+    static constexpr float PIPE_WIDTH = 72.f;
+    static constexpr float PIPE_CAP_H = 28.f;
+    static constexpr float PIPE_CAP_OVERHANG = 6.f;
+    static constexpr float PIPE_OUTLINE = 3.f;
+    static constexpr float GROUND_H = 80.f;
+    static constexpr float BIRD_START_X = 600.f * 0.25f;
+    static constexpr float BIRD_START_Y = 800.f * 0.4f;
+
+    SimWorld(float width, float height, std::uint64_t seed = 0);
+
+    template <class Real = SimReal> unsigned step(float dt);
+    // Pipes only: spawn, scroll, score and ramp exactly as step() does, with
+    // no bird physics or collision. Lays out a course for analysis tools.
+    template <class Real = SimReal> unsigned stepCourse(float dt);
+    // Arithmetic picked at run time, for replays that name theirs
+    unsigned step(float dt, SimPhysics physics) {
+        return physics == SimPhysics::FIXED ? step<Fixed>(dt) : step<float>(dt);
+    }
+    void reset();                      // keeps drawing from the current stream
+    void reset(std::uint64_t seed);    // regenerates the course for this seed
+    void flap() { if (!bird.isDead()) bird.flap(); }
+    void idle(float dt);
+
+    // Bird and next gap for agents; same layout as BatchEnv::Obs
+    void observe(float* out) const;
+
+    // Bit patterns of everything that decides the rest of the run. Under
+    // Fixed it is the same on every build after the same ticks.
+    std::uint64_t stateHash() const;
+
+    void save(SimSnapshot& out) const;
+    void restore(const SimSnapshot& in);
+
+    void setBounds(float width, float height);
+    void setDifficulty(const DifficultyParams& d);
+    void setHitboxMode(HitboxMode mode) { hitbox = mode; }
+    // Not owned; nullptr (the default) draws gaps uniformly. Takes effect
+    // at the next reset.
+    void setGapSource(GapSource* source) { gapSource = source; }
+    GapSource* getGapSource() const { return gapSource; }
+
+    const SimBird& getBird() const { return bird; }
+    SimBird& getBird() { return bird; }
+    const PipeRing& getPipes() const { return pipes; }
+
+    int   getScore() const { return score; }
+    int   getPipesSpawned() const { return spawned; }   // since reset; pipes[i] is spawn number spawned - size + i
+    std::uint32_t getTick() const { return tick; }   // steps since reset
+    bool  isOver() const { return over; }
+    const DifficultyParams& getDifficulty() const { return difficulty; }
+    HitboxMode getHitboxMode() const { return hitbox; }
+    float getPipeSpeed() const { return difficulty.pipeSpeed; }
+    float getWidth() const { return width; }
+    float getHeight() const { return height; }
+    float getGroundY() const { return height - GROUND_H; }
+    // Range of gap centres a pipe spawned now may get
+    static float getGapMinY() { return 140.f; }
+    float getGapMaxY() const { return height - GROUND_H - difficulty.pipeGap * 0.5f; }
+
+    // Most pipes that can be alive at once for this width and difficulty,
+    // including every step of the score ramp
+    static int pipeCapacityFor(float width, const DifficultyParams& d);
+
+private:
+    float width, height;
+    SimBird bird;
+    PipeRing pipes;
+    Rng rng;
+
+    DifficultyParams baseDifficulty;   // restored by reset()
+    DifficultyParams difficulty;       // current, after the score ramp
+    HitboxMode hitbox;
+    GapSource* gapSource;
+    float pipeSpawnTimer;
+    int   spawned;
+    int   score;
+    bool  over;
+    std::uint32_t tick;
+
+    template <class Real> void spawnPipe();
+    template <class Real> unsigned advancePipes(float dt);
+    void resizePipes();
+    template <class Real>
+    bool checkCollision(const SimPipe& p, const BasicSimRect<Real>& birdBounds, Real sweepX, Real sweepY) const;
+};
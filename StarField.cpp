@@ -0,0 +1,116 @@
+#include "StarField.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static const float PI_S   = 3.14159265f;
+static const float TWO_PI = 2.f * PI_S;
+
+// sin on [-π, π): parabola through the zeros and peaks, then one
+// refinement step; the error is about 0.001, well under one alpha step
+static const float SIN_B = 4.f / PI_S;
+static const float SIN_C = -4.f / (PI_S * PI_S);
+static const float SIN_P = 0.225f;
+
+StarField::StarField() : count(0), vertices(sf::Quads) {}
+
+void StarField::build(int n, float w, float h, Rng& rng) {
+    count = std::max(n, 0);
+    const std::size_t padded = static_cast<std::size_t>((count + 3) & ~3);
+    x.assign(static_cast<std::size_t>(count), 0.f);
+    y.assign(static_cast<std::size_t>(count), 0.f);
+    radius.assign(static_cast<std::size_t>(count), 0.f);
+    phase.assign(padded, 0.f);
+    speed.assign(padded, 0.f);
+    alpha.assign(padded, 0);
+
+    for (int i = 0; i < count; ++i) {
+        radius[i] = 1.f + rng.below(2);
+        x[i]      = static_cast<float>(rng.below(static_cast<int>(w)));
+        y[i]      = static_cast<float>(rng.below(static_cast<int>(h)));
+        phase[i]  = std::fmod(static_cast<float>(rng.below(100)) / 10.f, TWO_PI);
+        speed[i]  = 0.5f + rng.uniform() * 1.5f;
+    }
+
+    // Quads never move: positions and texture corners are written once
+    vertices.resize(static_cast<std::size_t>(count) * 4);
+    const float t = static_cast<float>(DOT);
+    for (int i = 0; i < count; ++i) {
+        const float r = radius[i];
+        sf::Vertex* q = &vertices[static_cast<std::size_t>(i) * 4];
+        q[0] = sf::Vertex(sf::Vector2f(x[i] - r, y[i] - r), sf::Color::White, sf::Vector2f(0.f, 0.f));
+        q[1] = sf::Vertex(sf::Vector2f(x[i] + r, y[i] - r), sf::Color::White, sf::Vector2f(t,   0.f));
+        q[2] = sf::Vertex(sf::Vector2f(x[i] + r, y[i] + r), sf::Color::White, sf::Vector2f(t,   t));
+        q[3] = sf::Vertex(sf::Vector2f(x[i] - r, y[i] + r), sf::Color::White, sf::Vector2f(0.f, t));
+    }
+
+    // White disc with a one-pixel soft edge; vertex colours carry the alpha
+    sf::Image img;
+    img.create(DOT, DOT, sf::Color::Transparent);
+    const float c = DOT * 0.5f;
+    for (int py = 0; py < DOT; ++py)
+        for (int px = 0; px < DOT; ++px) {
+            const float d = std::hypot(px + 0.5f - c, py + 0.5f - c);
+            const float a = std::min(std::max(c - 0.5f - d, 0.f), 1.f);
+            img.setPixel(px, py, sf::Color(255, 255, 255, static_cast<sf::Uint8>(a * 255.f)));
+        }
+    dot.loadFromImage(img);
+    dot.setSmooth(true);
+}
+
+void StarField::update(float dt) {
+    const std::size_t n = phase.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        float p = phase[i] + speed[i] * dt;
+        phase[i] = p >= TWO_PI ? p - TWO_PI : p;
+    }
+}
+
+// sin(phase) = -sin(phase - π), which puts the argument in [-π, π)
+void StarField::computeAlphas(int n, float brightness) {
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128 vpi   = _mm_set1_ps(PI_S);
+    const __m128 vb    = _mm_set1_ps(SIN_B);
+    const __m128 vc    = _mm_set1_ps(SIN_C);
+    const __m128 vp    = _mm_set1_ps(SIN_P);
+    const __m128 sign  = _mm_set1_ps(-0.f);
+    const __m128 vbase = _mm_set1_ps(80.f * brightness);
+    const __m128 vamp  = _mm_set1_ps(-120.f * brightness);   // folds in the sign flip
+    const __m128 vzero = _mm_setzero_ps();
+    const __m128 vmax  = _mm_set1_ps(255.f);
+    for (; i < n; i += 4) {
+        const __m128 xv = _mm_sub_ps(_mm_loadu_ps(&phase[static_cast<std::size_t>(i)]), vpi);
+        __m128 s = _mm_add_ps(_mm_mul_ps(vb, xv), _mm_mul_ps(vc, _mm_mul_ps(xv, _mm_andnot_ps(sign, xv))));
+        s = _mm_add_ps(_mm_mul_ps(vp, _mm_sub_ps(_mm_mul_ps(s, _mm_andnot_ps(sign, s)), s)), s);
+        __m128 a = _mm_add_ps(vbase, _mm_mul_ps(vamp, s));
+        a = _mm_min_ps(_mm_max_ps(a, vzero), vmax);
+        const __m128i v32 = _mm_cvtps_epi32(a);
+        const __m128i v8  = _mm_packus_epi16(_mm_packs_epi32(v32, v32), v32);
+        const int packed  = _mm_cvtsi128_si32(v8);
+        std::memcpy(&alpha[static_cast<std::size_t>(i)], &packed, 4);
+    }
+#endif
+    for (; i < n; ++i) {
+        const float xv = phase[static_cast<std::size_t>(i)] - PI_S;
+        float s = SIN_B * xv + SIN_C * (xv * std::fabs(xv));
+        s = SIN_P * (s * std::fabs(s) - s) + s;
+        const float a = std::min(std::max(80.f * brightness + (-120.f * brightness) * s, 0.f), 255.f);
+        alpha[static_cast<std::size_t>(i)] = static_cast<std::uint8_t>(std::nearbyint(a));
+    }
+}
+
+void StarField::draw(sf::RenderTarget& target, int shown, float brightness) {
+    const int n = std::min(std::max(shown, 0), count);
+    if (n == 0) return;
+    computeAlphas(n, brightness);
+    for (int i = 0; i < n; ++i) {
+        const sf::Uint8 a = alpha[static_cast<std::size_t>(i)];
+        sf::Vertex* q = &vertices[static_cast<std::size_t>(i) * 4];
+        q[0].color.a = a; q[1].color.a = a; q[2].color.a = a; q[3].color.a = a;
+    }
+    target.draw(&vertices[0], static_cast<std::size_t>(n) * 4, sf::Quads, sf::RenderStates(&dot));
+}
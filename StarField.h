@@ -0,0 +1,39 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Rng.h"
+
+// ─── Star field ───────────────────────────────────────────────────────────
+// Night-sky stars as structure-of-arrays (position, size, twinkle phase and
+// speed). Twinkle alphas come from a polynomial sin, four stars at a time
+// with SSE2, and each star is a quad textured with a soft round dot, all in
+// one vertex array: the whole field is a single draw call however many
+// stars it holds. Positions never change after build(), so a frame only
+// rewrites vertex alphas.
+class StarField {
+public:
+    StarField();
+
+    // Scatters count stars over [0, w) x [0, h) and bakes the dot texture
+    void build(int count, float w, float h, Rng& rng);
+    void update(float dt);
+    // The first `shown` stars (clamped to the field); alpha follows the old
+    // per-star rule, (80 + 120 sin(phase)) * brightness, clamped to 0..255
+    void draw(sf::RenderTarget& target, int shown, float brightness);
+
+    int getCount() const { return count; }
+
+private:
+    static constexpr int DOT = 16;   // dot texture size, px
+
+    int count;
+    std::vector<float> x, y, radius;
+    std::vector<float> phase;   // [0, 2π), padded to a multiple of 4
+    std::vector<float> speed;   // rad/s, padded like phase
+    std::vector<std::uint8_t> alpha;
+    sf::VertexArray vertices;
+    sf::Texture     dot;
+
+    void computeAlphas(int n, float brightness);
+};
@@ -0,0 +1,110 @@
+#include "WorkPool.h"
+#include <algorithm>
+
+static inline std::uint64_t pack(std::uint32_t begin, std::uint32_t end) {
+    return static_cast<std::uint64_t>(begin) | (static_cast<std::uint64_t>(end) << 32);
+}
+static inline std::uint32_t spanBegin(std::uint64_t s) { return static_cast<std::uint32_t>(s); }
+static inline std::uint32_t spanEnd(std::uint64_t s)   { return static_cast<std::uint32_t>(s >> 32); }
+
+WorkPool::WorkPool(unsigned threadCount)
+    : workers(std::max(1u, threadCount)), slices(new Slice[std::max(1u, threadCount)]),
+      current(nullptr), round(0), active(0), quit(false), steals(0)
+{
+    for (unsigned w = 1; w < workers; ++w) threads.emplace_back(&WorkPool::loop, this, w);
+}
+
+WorkPool::~WorkPool() {
+    {
+        std::lock_guard<std::mutex> g(lock);
+        quit = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+void WorkPool::run(int count, const Task& task) {
+    if (count <= 0) return;
+    const std::uint32_t n = static_cast<std::uint32_t>(count);
+    for (unsigned w = 0; w < workers; ++w) {
+        const std::uint32_t b = static_cast<std::uint32_t>(static_cast<std::uint64_t>(n) * w / workers);
+        const std::uint32_t e = static_cast<std::uint32_t>(static_cast<std::uint64_t>(n) * (w + 1) / workers);
+        slices[w].span.store(pack(b, e));
+    }
+    {
+        std::lock_guard<std::mutex> g(lock);
+        current = &task;
+        active  = workers;
+        ++round;
+    }
+    wake.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> g(lock);
+    if (--active > 0) finished.wait(g, [this]{ return active == 0; });
+    current = nullptr;
+}
+
+void WorkPool::loop(unsigned worker) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> g(lock);
+            wake.wait(g, [&]{ return quit || round != seen; });
+            if (quit) return;
+            seen = round;
+        }
+        drain(worker);
+        std::lock_guard<std::mutex> g(lock);
+        if (--active == 0) finished.notify_one();
+    }
+}
+
+void WorkPool::drain(unsigned worker) {
+    int index;
+    for (;;) {
+        while (take(worker, index)) (*current)(index, worker);
+        if (!steal(worker)) return;
+    }
+}
+
+// Owner side: one index off the front of its own slice
+bool WorkPool::take(unsigned worker, int& index) {
+    std::atomic<std::uint64_t>& span = slices[worker].span;
+    std::uint64_t s = span.load();
+    while (spanBegin(s) < spanEnd(s)) {
+        if (span.compare_exchange_weak(s, pack(spanBegin(s) + 1, spanEnd(s)))) {
+            index = static_cast<int>(spanBegin(s));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Thief side: the back half of the fullest slice becomes the thief's own.
+// Only the owner ever grows a slice, and only while it is empty, so a
+// thief that lost a race simply rescans.
+bool WorkPool::steal(unsigned thief) {
+    for (;;) {
+        unsigned      victim = thief;
+        std::uint32_t most   = 0;
+        for (unsigned k = 1; k < workers; ++k) {
+            const unsigned w = (thief + k) % workers;
+            const std::uint64_t s = slices[w].span.load();
+            const std::uint32_t left = spanEnd(s) > spanBegin(s) ? spanEnd(s) - spanBegin(s) : 0;
+            if (left > most) { most = left; victim = w; }
+        }
+        if (victim == thief) return false;
+
+        std::atomic<std::uint64_t>& span = slices[victim].span;
+        std::uint64_t s = span.load();
+        const std::uint32_t b = spanBegin(s), e = spanEnd(s);
+        if (b >= e) continue;
+        const std::uint32_t half = (e - b + 1) / 2;
+        if (!span.compare_exchange_strong(s, pack(b, e - half))) continue;
+        slices[thief].span.store(pack(e - half, e));
+        ++steals;
+        return true;
+    }
+}
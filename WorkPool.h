@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ─── Work-stealing thread pool ────────────────────────────────────────────
+// run(count, task) calls task(index, worker) once for every index in
+// [0, count) and returns when all are done. The range is split into one
+// contiguous slice per worker; a worker takes indices from the front of
+// its own slice and, once it is empty, steals the back half of the
+// fullest other slice. Tasks that cost wildly different amounts (a good
+// controller survives a thousand times longer than a bad one) still end
+// together.
+//
+// A slice is a single 64-bit word (begin | end << 32) updated by CAS, so
+// taking and stealing never lock. The calling thread works as worker 0.
+
+class WorkPool {
+public:
+    using Task = std::function<void(int index, unsigned worker)>;
+
+    explicit WorkPool(unsigned threads);
+    ~WorkPool();
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    unsigned size() const { return workers; }
+    void run(int count, const Task& task);
+
+    std::uint64_t getSteals() const { return steals.load(); }   // since construction
+
+private:
+    struct alignas(64) Slice {
+        std::atomic<std::uint64_t> span{ 0 };
+    };
+
+    unsigned workers;
+    std::unique_ptr<Slice[]> slices;
+    std::vector<std::thread> threads;
+
+    std::mutex              lock;
+    std::condition_variable wake, finished;
+    const Task*   current;
+    std::uint64_t round;     // bumped by run(): a new round of work
+    unsigned      active;    // workers still inside this round
+    bool          quit;
+    std::atomic<std::uint64_t> steals;
+
+    void loop(unsigned worker);
+    void drain(unsigned worker);
+    bool take(unsigned worker, int& index);
+    bool steal(unsigned thief);
+};
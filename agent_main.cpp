@@ -0,0 +1,165 @@
+#include "AgentProtocol.h"
+#include <SFML/Network.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Plays against a running `--serve` game (or `--headless` server) over
+// AgentProtocol and measures the link:
+//   FlappyAgent [--port P] [--steps N] [--depth D] [--batch B] [--seed S]
+// Keeps D requests in flight, each a step (B = 1) or a batch of B steps.
+// The policy sees the newest observation that has come back, so deeper
+// pipelines trade reaction time for throughput: it flaps when the bird is
+// falling past a line AIM px below the next gap's centre, on the first
+// action of a request only. Reports round-trip percentiles per request,
+// steps/s, episodes and the mean score.
+
+static const float AIM = 45.f;
+
+struct InFlight {
+    bool reset;
+    std::chrono::steady_clock::time_point sent;
+};
+
+static double percentile(std::vector<double>& v, double q) {
+    if (v.empty()) return 0.0;
+    const std::size_t k = std::min(v.size() - 1, static_cast<std::size_t>(q * static_cast<double>(v.size())));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return v[k];
+}
+
+int main(int argc, char** argv) {
+    int           port  = 7777;
+    long          steps = 100000;
+    int           depth = 8;
+    int           batch = 1;
+    std::uint64_t seed  = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if      (a == "--port" && i + 1 < argc)  port  = std::atoi(argv[++i]);
+        else if (a == "--steps" && i + 1 < argc) steps = std::max(1L, std::atol(argv[++i]));
+        else if (a == "--depth" && i + 1 < argc) depth = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--batch" && i + 1 < argc) batch = std::min(std::max(std::atoi(argv[++i]), 1), static_cast<int>(AGENT_MAX_BATCH));
+        else if (a == "--seed" && i + 1 < argc)  seed  = std::strtoull(argv[++i], nullptr, 10);
+    }
+
+    sf::TcpSocket socket;
+    if (socket.connect(sf::IpAddress::LocalHost, static_cast<unsigned short>(port), sf::seconds(5.f)) != sf::Socket::Done) {
+        std::fprintf(stderr, "cannot connect to 127.0.0.1:%d\n", port);
+        return 1;
+    }
+
+    std::deque<InFlight>      inFlight;
+    std::vector<std::uint8_t> out, in, actions(static_cast<std::size_t>(batch), 0);
+    std::vector<double>       rtts;
+    AgentState latest{};
+    bool   haveState   = false;
+    bool   resetQueued = false;   // a reset is in flight: ignore dones until it lands
+    bool   needReset   = true;
+    long   sentSteps   = 0;
+    long   doneSteps   = 0;
+    long   episodes    = 0;
+    double scoreSum    = 0.0;
+    std::size_t readPos = 0;
+
+    auto onState = [&](const AgentState& s) {
+        latest    = s;
+        haveState = true;
+        if (s.done && !needReset && !resetQueued) {
+            ++episodes;
+            scoreSum += s.score;
+            needReset = true;
+        }
+    };
+
+    const auto t0 = std::chrono::steady_clock::now();
+    while (doneSteps < steps) {
+        // Top the pipeline up
+        out.clear();
+        while (static_cast<int>(inFlight.size()) < depth && (needReset || sentSteps < steps)) {
+            if (needReset) {
+                if (resetQueued) break;
+                putAgentReset(out, seed++);
+                resetQueued = true;
+                needReset   = false;
+                inFlight.push_back({ true, std::chrono::steady_clock::now() });
+                continue;
+            }
+            const int n = static_cast<int>(std::min<long>(batch, steps - sentSteps));
+            bool flap = false;
+            if (haveState) {
+                const float centre = (latest.obs[SIM_OBS_PIPE_TOP] + latest.obs[SIM_OBS_PIPE_BOT]) * 0.5f;
+                flap = latest.obs[SIM_OBS_Y] > centre + AIM && latest.obs[SIM_OBS_VELOCITY] > 0.f;
+            }
+            if (batch == 1) putAgentStep(out, flap);
+            else {
+                std::fill(actions.begin(), actions.end(), 0);
+                actions[0] = flap ? 1 : 0;
+                putAgentBatch(out, actions.data(), static_cast<std::uint16_t>(n));
+            }
+            sentSteps += n;
+            inFlight.push_back({ false, std::chrono::steady_clock::now() });
+            haveState = false;   // one decision per observation
+        }
+        if (!out.empty() && socket.send(out.data(), out.size()) != sf::Socket::Done) {
+            std::fprintf(stderr, "send failed\n");
+            return 1;
+        }
+
+        // Read until at least one reply is complete
+        std::uint8_t buf[16384];
+        std::size_t  got = 0;
+        if (socket.receive(buf, sizeof(buf), got) != sf::Socket::Done) {
+            std::fprintf(stderr, "server closed the connection\n");
+            return 1;
+        }
+        in.insert(in.end(), buf, buf + got);
+
+        for (;;) {
+            const std::size_t left = in.size() - readPos;
+            const std::uint8_t* p = in.data() + readPos;
+            if (left < 1) break;
+            if (p[0] == AGENT_ERROR) {
+                std::fprintf(stderr, "server rejected opcode 0x%02x\n", left > 1 ? p[1] : 0);
+                return 1;
+            }
+            std::size_t size;
+            int count = 1;
+            if (p[0] == AGENT_RECORD) size = 1 + AGENT_STATE_SIZE;
+            else {
+                if (left < 3) break;
+                count = p[1] | (p[2] << 8);
+                size  = 3 + static_cast<std::size_t>(count) * AGENT_STATE_SIZE;
+            }
+            if (left < size) break;
+
+            const InFlight req = inFlight.front();
+            inFlight.pop_front();
+            rtts.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - req.sent).count());
+            const std::uint8_t* s = p + (p[0] == AGENT_RECORD ? 1 : 3);
+            if (req.reset) {
+                resetQueued = false;
+                onState(readAgentState(s));
+            } else {
+                for (int k = 0; k < count; ++k) onState(readAgentState(s + static_cast<std::size_t>(k) * AGENT_STATE_SIZE));
+                doneSteps += count;
+            }
+            readPos += size;
+        }
+        if (readPos == in.size()) { in.clear(); readPos = 0; }
+    }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::printf("%ld steps in %.2f s  |  %.0f steps/s  |  depth %d, batch %d\n",
+                doneSteps, secs, static_cast<double>(doneSteps) / secs, depth, batch);
+    std::printf("round trip (us): p50 %.1f  p90 %.1f  p99 %.1f  max %.1f  over %zu requests\n",
+                percentile(rtts, 0.50), percentile(rtts, 0.90), percentile(rtts, 0.99),
+                rtts.empty() ? 0.0 : *std::max_element(rtts.begin(), rtts.end()), rtts.size());
+    std::printf("%ld episodes finished, mean score %.2f\n",
+                episodes, episodes > 0 ? scoreSum / static_cast<double>(episodes) : 0.0);
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "Reachability.h"
+#include "FairGaps.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Generates courses from consecutive seeds and asks ReachSolver whether a
+// flap sequence survives each one:
+//   FlappyAudit [--courses N] [--pipes P] [--difficulty 0|1|2] [--seed S]
+//               [--hz H] [--bin B] [--gaps uniform|fair] [--threads T]
+// Reports how many courses are beatable and at which pipe the others become
+// impossible. BOX hitbox, 600x800 world. Once its table of pipe episodes
+// is warm a uniform course costs a few hundred microseconds on every
+// difficulty; fair gaps add the planner's proofs, tens of milliseconds a
+// course. The summary line gives the cost per course and per pipe.
+
+int main(int argc, char** argv) {
+    long          courses    = 100000;
+    int           pipes      = 50;
+    int           difficulty = 1;
+    std::uint64_t seed       = 1;
+    int           hz         = 120;
+    float         bin        = 2.f;
+    GapLayout     layout     = GapLayout::UNIFORM;
+    unsigned      threads    = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if      (a == "--courses" && i + 1 < argc)    courses    = std::max(1L, std::atol(argv[++i]));
+        else if (a == "--pipes" && i + 1 < argc)      pipes      = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--difficulty" && i + 1 < argc) difficulty = std::min(std::max(std::atoi(argv[++i]), 0), 2);
+        else if (a == "--seed" && i + 1 < argc)       seed       = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--hz" && i + 1 < argc)         hz         = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--bin" && i + 1 < argc)        bin        = std::max(0.25f, static_cast<float>(std::atof(argv[++i])));
+        else if (a == "--gaps" && i + 1 < argc)       layout     = std::string(argv[++i]) == "fair" ? GapLayout::FAIR : GapLayout::UNIFORM;
+        else if (a == "--threads" && i + 1 < argc)    threads    = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+    }
+    const float dt = 1.f / static_cast<float>(hz);
+    const DifficultyParams params = DifficultyParams::forLevel(static_cast<Difficulty>(difficulty));
+    bin = ReachSolver(SimWorld(600.f, 800.f).getGroundY(), dt, bin).getBinSize();
+
+    // failPipe[c]: course index of the pipe where course c becomes
+    // impossible, or -1 if it is beatable
+    std::vector<int> failPipe(static_cast<std::size_t>(courses), -1);
+
+    // Work queue: workers claim blocks of courses until all are done
+    const long BLOCK = 64;
+    std::atomic<long>          next{ 0 };
+    std::atomic<std::uint64_t> ticks{ 0 };
+    std::atomic<long>          unproven{ 0 };
+    auto worker = [&]() {
+        SimWorld    world(600.f, 800.f);
+        world.setDifficulty(params);
+        GapPlanner  planner;
+        planner.setParams(FairGapParams::forLevel(static_cast<Difficulty>(difficulty)));
+        planner.setStep(dt);
+        if (layout == GapLayout::FAIR) world.setGapSource(&planner);
+        ReachSolver solver(world.getGroundY(), dt, bin);
+        CourseTrace trace;
+        std::uint64_t solved = 0;   // course ticks covered
+        long          guessed = 0;  // fair gaps committed without a proof
+        for (long b = next.fetch_add(BLOCK); b < courses; b = next.fetch_add(BLOCK)) {
+            for (long c = b; c < std::min(b + BLOCK, courses); ++c) {
+                world.reset(seed + static_cast<std::uint64_t>(c));
+                const float startY = world.getBird().y;
+                traceCourse(world, pipes, dt, trace);
+                if (layout == GapLayout::FAIR) guessed += planner.getUnproven();
+                const int n = static_cast<int>(trace.lo.size());
+                int fail = solver.solveCourse(startY, trace);
+                if (fail >= 0) failPipe[static_cast<std::size_t>(c)] = trace.pipe[fail];
+                solved += static_cast<std::uint64_t>(n);
+            }
+        }
+        ticks    += solved;
+        unproven += guessed;
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::vector<long> byPipe(static_cast<std::size_t>(pipes), 0);
+    long impossible = 0;
+    for (long c = 0; c < courses; ++c) {
+        int p = failPipe[static_cast<std::size_t>(c)];
+        if (p < 0) continue;
+        ++impossible;
+        ++byPipe[static_cast<std::size_t>(std::min(p, pipes - 1))];
+    }
+
+    static const char* NAMES[] = { "EASY", "NORMAL", "HARD" };
+    std::printf("%ld courses  |  %s, %d pipes, %d Hz, %.2g px bins, %s gaps\n",
+                courses, NAMES[difficulty], pipes, hz, bin,
+                layout == GapLayout::FAIR ? "fair" : "uniform");
+    std::printf("beatable    : %ld (%.4f%%)\n", courses - impossible,
+                100.0 * static_cast<double>(courses - impossible) / static_cast<double>(courses));
+    std::printf("impossible  : %ld\n", impossible);
+    if (layout == GapLayout::FAIR)
+        std::printf("unproven    : %ld gaps committed after every draw failed\n", unproven.load());
+    if (impossible > 0) {
+        std::printf("first impossible pipe:\n");
+        for (int p = 0; p < pipes; ++p)
+            if (byPipe[static_cast<std::size_t>(p)] > 0)
+                std::printf("  pipe %3d : %ld\n", p, byPipe[static_cast<std::size_t>(p)]);
+        std::printf("examples    :");
+        int shown = 0;
+        for (long c = 0; c < courses && shown < 5; ++c) {
+            if (failPipe[static_cast<std::size_t>(c)] < 0) continue;
+            std::printf(" seed %llu (pipe %d)", static_cast<unsigned long long>(seed + static_cast<std::uint64_t>(c)),
+                        failPipe[static_cast<std::size_t>(c)]);
+            ++shown;
+        }
+        std::printf("\n");
+    }
+    std::printf("\n%u threads  |  %.3f s  |  %.1f us/course  |  %.2f us/pipe  |  %.3g course ticks/s\n",
+                threads, secs, secs * 1e6 / static_cast<double>(courses),
+                secs * 1e6 / (static_cast<double>(courses) * pipes),
+                static_cast<double>(ticks.load()) / secs);
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include "BatchEnv.h"
+#include "BirdHull.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Headless throughput check for BatchEnv:
+//   FlappyBench [--worlds N] [--steps S] [--difficulty 0|1|2] [--scalar] [--hitbox box|hull]
+// With --hitbox hull it also times the bird-hull SAT test on its own.
+
+// Rects scattered around the bird so most pass the bounds reject and run
+// the full separating-axis test
+static void benchHull() {
+    const BirdHull& hull = BirdHull::instance();
+    Rng rng(3, RNG_STREAM_COSMETIC);
+    const int N = 4096;
+    std::vector<SimRect> rects(N);
+    std::vector<float>   rots(N);
+    for (int i = 0; i < N; ++i) {
+        rects[i] = SimRect{ rng.uniform(-90.f, 40.f), rng.uniform(-90.f, 40.f),
+                            rng.uniform(10.f, 90.f), rng.uniform(10.f, 90.f) };
+        rots[i]  = rng.uniform(-30.f, 90.f);
+    }
+    const int rounds = 500;
+    long hits = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (int i = 0; i < N; ++i)
+            hits += hull.hitsRect(0.f, 0.f, rots[i], 2.7f, static_cast<float>(r % 9) - 4.f, rects[i]);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    double tests = static_cast<double>(rounds) * N;
+    std::printf("hull tests  : %.0f (%ld hits)\n", tests, hits);
+    std::printf("ns/test     : %.1f\n", secs * 1e9 / tests);
+}
+
+int main(int argc, char** argv) {
+    int  worlds     = 16384;
+    int  steps      = 2000;
+    int  difficulty = 1;
+    bool scalar     = false;
+    bool hull       = false;
+    for (int i = 1; i < argc; ++i) {
+        if      (std::strcmp(argv[i], "--worlds") == 0 && i + 1 < argc)     worlds     = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--steps") == 0 && i + 1 < argc)      steps      = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) difficulty = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--scalar") == 0)                     scalar     = true;
+        else if (std::strcmp(argv[i], "--hitbox") == 0 && i + 1 < argc)     hull       = std::strcmp(argv[++i], "hull") == 0;
+    }
+
+    BatchEnv env(worlds, static_cast<Difficulty>(difficulty), 1);
+    env.setSimd(!scalar);
+    if (hull) env.setHitboxMode(HitboxMode::HULL);
+
+    // Random flaps at roughly the rate a player taps
+    Rng actionRng(7, RNG_STREAM_COSMETIC);
+    std::vector<std::uint8_t> actions(static_cast<size_t>(worlds));
+    double reward = 0.0;
+    for (int s = 0; s < steps; ++s) {
+        for (auto& a : actions) a = actionRng.below(12) == 0;
+        env.step(actions.data());
+        const float* r = env.getRewards();
+        for (int i = 0; i < worlds; ++i) reward += r[i];
+    }
+
+    std::printf("kernel      : %s\n", (env.simdAvailable() && !scalar && !hull) ? "AVX2" : "scalar");
+    std::printf("hitbox      : %s\n", hull ? "hull" : "box");
+    std::printf("worlds      : %d\n", worlds);
+    std::printf("world steps : %llu\n", static_cast<unsigned long long>(env.getTotalSteps()));
+    std::printf("episodes    : %llu\n", static_cast<unsigned long long>(env.getEpisodes()));
+    std::printf("reward sum  : %.0f\n", reward);
+    std::printf("steps/s     : %.3g\n", env.getStepsPerSecond());
+    if (hull) benchHull();
+    return 0;
+}
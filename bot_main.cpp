@@ -0,0 +1,109 @@
+#include "Autopilot.h"
+#include "FairGaps.h"
+#include "Replay.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Plays consecutive seeds with the Autopilot, headless and single-threaded
+// so the decision latencies are those of one game thread:
+//   FlappyBot [--runs N] [--seed S] [--difficulty 0|1|2] [--hz H]
+//             [--hitbox box|hull] [--gaps uniform|fair] [--budget US]
+//             [--nodes N] [--max-seconds T] [--record DIR]
+// --nodes swaps the time budget for a node budget, so scores are the same
+// on any machine; --record writes each run as a replay for FlappyVerify.
+
+int main(int argc, char** argv) {
+    int           runs       = 20;
+    std::uint64_t seed       = 1;
+    int           difficulty = 1;
+    int           hz         = 120;
+    HitboxMode    hitbox     = HitboxMode::BOX;
+    GapLayout     layout     = GapLayout::UNIFORM;
+    float         maxSeconds = 120.f;
+    std::string   recordDir;
+    AutopilotParams params;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if      (a == "--runs" && i + 1 < argc)        runs       = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--seed" && i + 1 < argc)        seed       = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--difficulty" && i + 1 < argc)  difficulty = std::min(std::max(std::atoi(argv[++i]), 0), 2);
+        else if (a == "--hz" && i + 1 < argc)          hz         = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--hitbox" && i + 1 < argc)      hitbox     = std::string(argv[++i]) == "hull" ? HitboxMode::HULL : HitboxMode::BOX;
+        else if (a == "--gaps" && i + 1 < argc)        layout     = std::string(argv[++i]) == "fair" ? GapLayout::FAIR : GapLayout::UNIFORM;
+        else if (a == "--budget" && i + 1 < argc)      params.budgetMicros = static_cast<float>(std::atof(argv[++i]));
+        else if (a == "--nodes" && i + 1 < argc)       params.maxNodes     = std::max(0, std::atoi(argv[++i]));
+        else if (a == "--max-seconds" && i + 1 < argc) maxSeconds = static_cast<float>(std::atof(argv[++i]));
+        else if (a == "--record" && i + 1 < argc)      recordDir  = argv[++i];
+    }
+    if (!recordDir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(recordDir, ec);
+    }
+
+    const float dt = 1.f / static_cast<float>(hz);
+    const Difficulty level = static_cast<Difficulty>(difficulty);
+    const std::uint32_t maxTicks = static_cast<std::uint32_t>(maxSeconds * static_cast<float>(hz));
+
+    SimWorld   world(600.f, 800.f);
+    world.setDifficulty(DifficultyParams::forLevel(level));
+    world.setHitboxMode(hitbox);
+    GapPlanner planner;
+    planner.setParams(FairGapParams::forLevel(level));
+    planner.setStep(dt);
+    if (layout == GapLayout::FAIR) world.setGapSource(&planner);
+    Autopilot  pilot(params);
+    Replay     replay;
+
+    std::vector<int> scores;
+    int capped = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; ++r) {
+        const std::uint64_t runSeed = seed + static_cast<std::uint64_t>(r);
+        world.reset(runSeed);
+        replay.begin(runSeed, level, hitbox, layout, static_cast<std::uint32_t>(hz), 600, 800);
+        while (!world.isOver() && world.getTick() < maxTicks) {
+            if (layout == GapLayout::FAIR) planner.advance(GapPlanner::WORK_PER_TICK);
+            if (pilot.decide(world, dt)) {
+                replay.addFlap(world.getTick());
+                world.flap();
+            }
+            world.step(dt);
+        }
+        if (!world.isOver()) ++capped;
+        scores.push_back(world.getScore());
+        // A capped run never landed, so FlappyVerify could not reproduce it
+        if (!recordDir.empty() && world.isOver()) {
+            replay.tickCount = world.getTick();
+            replay.score     = static_cast<std::uint32_t>(world.getScore());
+            replay.save(recordDir + "/bot_" + std::to_string(runSeed) + ".fbr");
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::vector<int> sorted(scores);
+    std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    for (int s : scores) mean += s;
+    mean /= static_cast<double>(scores.size());
+
+    static const char* NAMES[] = { "EASY", "NORMAL", "HARD" };
+    std::printf("%d runs  |  %s, %d Hz, %s hitbox, %s gaps, ", runs, NAMES[difficulty], hz,
+                hitbox == HitboxMode::BOX ? "box" : "hull", layout == GapLayout::FAIR ? "fair" : "uniform");
+    if (params.maxNodes > 0) std::printf("%d nodes/decision\n", params.maxNodes);
+    else                     std::printf("%.0f us/decision\n", params.budgetMicros);
+    std::printf("score       : mean %.1f  median %d  min %d  max %d\n",
+                mean, sorted[sorted.size() / 2], sorted.front(), sorted.back());
+    std::printf("capped      : %d runs still alive after %.0f s\n", capped, maxSeconds);
+
+    const LatencyStats& lat = pilot.getLatency();
+    std::printf("decision us : p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f  (%llu decisions)\n",
+                lat.percentile(0.5f), lat.percentile(0.9f), lat.percentile(0.99f),
+                lat.percentile(0.999f), lat.getMax(), static_cast<unsigned long long>(lat.getCount()));
+    std::printf("\n%.3f s wall\n", secs);
+    return 0;
+}
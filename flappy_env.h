@@ -0,0 +1,104 @@
+#ifndef FLAPPY_ENV_H
+#define FLAPPY_ENV_H
+#include <stdint.h>
+
+/* ─── FlappyEnv C ABI ──────────────────────────────────────────────────────
+ * Gym-style access to the game rules (SimWorld) for agents written in any
+ * language with a C FFI. One handle owns `num_envs` independent worlds,
+ * allocated by flappy_create(); every other call only reads the caller's
+ * action buffer and writes straight into the caller's observation /
+ * reward / done buffers, so a step allocates and copies nothing.
+ *
+ * Observations are FLAPPY_OBS_SIZE floats per world, in world pixels:
+ * bird y and velocity, then x, gap top and gap bottom of the nearest pipe
+ * the bird has not yet flown past (x = width + 20, top = 0,
+ * bottom = ground when there is none). Same layout as BatchEnv.
+ *
+ * Rewards are +1 per pipe cleared and -1 on death. An episode is done when
+ * the bird dies (FLAPPY_DONE_DIED) or has flown `max_ticks` steps
+ * (FLAPPY_DONE_TRUNCATED).
+ *
+ * A handle is not thread-safe; separate handles may run on separate
+ * threads. Build with FLAPPY_BUILD_DLL defined to export the symbols.
+ */
+
+#if defined(_WIN32)
+#  if defined(FLAPPY_BUILD_DLL)
+#    define FLAPPY_API __declspec(dllexport)
+#  else
+#    define FLAPPY_API __declspec(dllimport)
+#  endif
+#else
+#  define FLAPPY_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLAPPY_ABI_VERSION 1
+
+enum {
+    FLAPPY_OBS_Y,
+    FLAPPY_OBS_VELOCITY,
+    FLAPPY_OBS_PIPE_X,
+    FLAPPY_OBS_PIPE_TOP,
+    FLAPPY_OBS_PIPE_BOT,
+    FLAPPY_OBS_SIZE
+};
+
+enum {
+    FLAPPY_DONE_NO        = 0,
+    FLAPPY_DONE_DIED      = 1,
+    FLAPPY_DONE_TRUNCATED = 2
+};
+
+typedef struct flappy_config {
+    int32_t  num_envs;     /* worlds in the handle, >= 1 */
+    int32_t  difficulty;   /* 0 easy, 1 normal, 2 hard */
+    int32_t  hitbox;       /* 0 box, 1 hull */
+    int32_t  gaps;         /* 0 uniform, 1 fair (see FairGaps.h) */
+    int32_t  tick_rate;    /* Hz; one step is 1 / tick_rate seconds */
+    int32_t  max_ticks;    /* episode length cap, 0 for none */
+    uint64_t seed;         /* world i starts on seed + i */
+} flappy_config;
+
+typedef struct flappy_env flappy_env;
+
+FLAPPY_API uint32_t flappy_abi_version(void);
+/* Normal difficulty, box hitbox, uniform gaps, 120 Hz, one world, no cap */
+FLAPPY_API void flappy_default_config(flappy_config* cfg);
+
+/* NULL if the config is out of range or allocation fails */
+FLAPPY_API flappy_env* flappy_create(const flappy_config* cfg);
+FLAPPY_API void        flappy_destroy(flappy_env* env);
+FLAPPY_API int32_t     flappy_num_envs(const flappy_env* env);
+
+/* Restarts every world, world i on seed + i. obs: num_envs * OBS_SIZE, may be NULL */
+FLAPPY_API void flappy_reset(flappy_env* env, uint64_t seed, float* obs);
+/* Restarts one world on `seed`. obs: OBS_SIZE, may be NULL */
+FLAPPY_API void flappy_reset_env(flappy_env* env, int32_t index, uint64_t seed, float* obs);
+
+/* Advances world `index` by one tick; action != 0 flaps first. Once done,
+ * further steps return done again with reward 0 until the world is reset.
+ * Any output pointer may be NULL. */
+FLAPPY_API void flappy_step(flappy_env* env, int32_t index, int32_t action,
+                            float* obs, float* reward, uint8_t* done);
+
+/* Advances every world by one tick. actions: num_envs bytes. Worlds that
+ * finish are reset at once (on their next seed: world i's k-th episode
+ * uses seed + i + k * num_envs), so obs always describes a live episode.
+ * scores receives the score at the end of the step — for a finished
+ * world, the score of the episode that just ended. Outputs are num_envs
+ * (obs: num_envs * OBS_SIZE) and may be NULL. */
+FLAPPY_API void flappy_step_batch(flappy_env* env, const uint8_t* actions,
+                                  float* obs, float* rewards, uint8_t* dones, int32_t* scores);
+
+/* Current observation of every world. obs: num_envs * OBS_SIZE */
+FLAPPY_API void flappy_observe(const flappy_env* env, float* obs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,7 +1,88 @@
 #include "Game.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
 
-int main() {
-    Game game;
+int main(int argc, char** argv) {
+    std::uint64_t seed     = static_cast<std::uint64_t>(std::time(nullptr));
+    int           tickRate = 0;
+    bool          variable = false;
+    bool          hullHitbox = false;
+    bool          fairGaps  = false;
+    bool          attract   = true;
+    const char*   recordDir  = nullptr;
+    const char*   replayPath = nullptr;
+    int           agentPort  = 0;
+    bool          headless   = false;
+    bool          once       = false;
+    int           difficulty = 1;
+    bool          vectorBird = false;
+    bool          cpuSky     = false;
+    int           starCount  = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc)
+            tickRate = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--variable-step") == 0)
+            variable = true;
+        else if (std::strcmp(argv[i], "--hitbox") == 0 && i + 1 < argc)
+            hullHitbox = std::strcmp(argv[++i], "hull") == 0;
+        else if (std::strcmp(argv[i], "--gaps") == 0 && i + 1 < argc)
+            fairGaps = std::strcmp(argv[++i], "fair") == 0;
+        else if (std::strcmp(argv[i], "--no-attract") == 0)
+            attract = false;
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            recordDir = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--serve") == 0 && i + 1 < argc)
+            agentPort = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if (std::strcmp(argv[i], "--once") == 0)
+            once = true;
+        else if (std::strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc)
+            difficulty = std::min(std::max(std::atoi(argv[++i]), 0), 2);
+        else if (std::strcmp(argv[i], "--vector-bird") == 0)
+            vectorBird = true;
+        else if (std::strcmp(argv[i], "--cpu-sky") == 0)
+            cpuSky = true;
+        else if (std::strcmp(argv[i], "--stars") == 0 && i + 1 < argc)
+            starCount = std::atoi(argv[++i]);
+    }
+
+    // No window: the agent steps a bare world as fast as it asks
+    if (headless) {
+        if (agentPort <= 0) agentPort = 7777;
+        AgentServer server;
+        if (!server.listen(static_cast<unsigned short>(agentPort))) return 1;
+        WorldHost host(static_cast<Difficulty>(difficulty),
+                       hullHitbox ? HitboxMode::HULL : HitboxMode::BOX,
+                       fairGaps ? GapLayout::FAIR : GapLayout::UNIFORM,
+                       1.f / static_cast<float>(tickRate > 0 ? tickRate : 120));
+        // --once: exit when the first client goes away
+        while (!once || server.getSessions() == 0) {
+            server.wait(sf::milliseconds(100));
+            server.poll(host, -1);
+        }
+        return 0;
+    }
+
+    Game game(seed);
+    if (tickRate > 0) game.setTickRate(tickRate);
+    if (variable)     game.setFixedStep(false);
+    if (hullHitbox)   game.setHitboxMode(HitboxMode::HULL);
+    if (fairGaps)     game.setGapLayout(GapLayout::FAIR);
+    if (!attract)     game.setAttractMode(false);
+    if (vectorBird)   game.setBirdSprites(false);
+    if (cpuSky)       game.setSkyShader(false);
+    if (starCount > 0) game.setStarCount(starCount);
+    if (recordDir)    game.setRecordDir(recordDir);
+    if (replayPath && !game.loadReplay(replayPath)) return 1;
+    if (agentPort > 0 && !game.serveAgent(static_cast<unsigned short>(agentPort))) return 1;
     game.run();
     return 0;
 }
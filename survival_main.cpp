@@ -0,0 +1,208 @@
+#include "BatchEnv.h"
+#include "FairGaps.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Monte Carlo difficulty analysis: a reference bot with human-like timing
+// noise plays many seeded courses per difficulty, and the share that reach
+// each score is written as survival curves:
+//   FlappySurvival [--courses N] [--difficulty 0|1|2|all] [--seed S] [--hz H]
+//                  [--hitbox box|hull] [--gaps uniform|fair] [--jitter MS]
+//                  [--cap SCORE] [--threads T] [--csv FILE]
+// CSV columns: score, then P(score >= N) for each difficulty run. A run
+// still alive at --cap is stopped and counted as reaching it. The hitbox
+// defaults to the game's (box). --gaps fair lays courses out with
+// GapPlanner, one per world, which proves every pipe with ReachSolver:
+// about 1 ms a pipe, so size --courses well below the uniform default.
+//
+// The bot flaps whenever it is falling past a line AIM px below the next
+// gap's centre. A flap climbs about 90 px, so the bird's 36 px box then
+// swings evenly about the centre, which is the most room a noisy flap can
+// get. Each flap lands |N(0, jitter)| late.
+// Courses run on BatchEnv in blocks of BLOCK_WORLDS worlds x
+// BLOCK_EPISODES episodes, claimed by threads from a shared counter, so
+// the curves do not depend on the thread count. A world that has played
+// its episodes is parked, so the tail of a block steps only live worlds.
+
+static const int   BLOCK_WORLDS   = 2048;
+static const int   BLOCK_EPISODES = 8;
+static const float AIM            = 45.f;    // px the flap line sits below the gap's centre
+
+struct Sweep {
+    std::vector<std::uint64_t> counts;   // final score, the last bin is >= cap
+    std::uint64_t ticks   = 0;
+    long          courses = 0;
+    double        secs    = 0.0;
+};
+
+// Plays one block of courses and adds them to `counts`
+static std::uint64_t playBlock(long block, Difficulty level, HitboxMode hitbox, GapLayout layout,
+                               std::uint64_t seed, float dt, float jitter, int cap,
+                               std::vector<std::uint64_t>& counts) {
+    const int W = BLOCK_WORLDS;
+    BatchEnv env(W, level, seed + static_cast<std::uint64_t>(block) * W, dt);
+    env.setHitboxMode(hitbox);
+    // One planner per world; they plan synchronously as pipes spawn
+    std::vector<GapPlanner> planners(layout == GapLayout::FAIR ? static_cast<std::size_t>(W) : 0);
+    for (int i = 0; i < static_cast<int>(planners.size()); ++i) {
+        planners[static_cast<std::size_t>(i)].setParams(FairGapParams::forLevel(level));
+        planners[static_cast<std::size_t>(i)].setStep(dt);
+        env.setGapSource(i, &planners[static_cast<std::size_t>(i)]);
+    }
+    Rng noise(seed + static_cast<std::uint64_t>(block), RNG_STREAM_COSMETIC);
+
+    std::vector<float>        obs(static_cast<std::size_t>(W) * BatchEnv::OBS_SIZE);
+    std::vector<std::uint8_t> actions(static_cast<std::size_t>(W), 0);
+    std::vector<int>          pending(static_cast<std::size_t>(W), -1);   // ticks until a scheduled flap
+    std::vector<int>          played(static_cast<std::size_t>(W), 0);
+    int active = W;
+    std::uint64_t ticks = 0;
+
+    while (active > 0) {
+        env.observe(obs.data());
+        for (int i = 0; i < W; ++i) {
+            const float* o = &obs[static_cast<std::size_t>(i) * BatchEnv::OBS_SIZE];
+            int& p = pending[static_cast<std::size_t>(i)];
+            if (p < 0 && played[static_cast<std::size_t>(i)] < BLOCK_EPISODES) {
+                const float centre = (o[BatchEnv::OBS_PIPE_TOP] + o[BatchEnv::OBS_PIPE_BOT]) * 0.5f;
+                if (o[BatchEnv::OBS_Y] > centre + AIM && o[BatchEnv::OBS_VELOCITY] > 0.f)
+                    p = jitter > 0.f ? static_cast<int>(std::fabs(noise.gaussian()) * jitter / dt + 0.5f) : 0;
+            }
+            actions[static_cast<std::size_t>(i)] = p == 0;
+            if (p >= 0) --p;
+        }
+        env.step(actions.data());
+        ticks += static_cast<std::uint64_t>(active);
+
+        const std::uint8_t* dones  = env.getDones();
+        const int*          last   = env.getLastScores();
+        const int*          scores = env.getScores();
+        for (int i = 0; i < W; ++i) {
+            if (!dones[i] && scores[i] >= cap) env.truncate(i);   // sets dones[i]
+            if (!dones[i]) continue;
+            pending[static_cast<std::size_t>(i)] = -1;
+            int& n = played[static_cast<std::size_t>(i)];
+            ++counts[static_cast<std::size_t>(std::min(last[i], cap))];
+            if (++n == BLOCK_EPISODES) { env.park(i); --active; }   // quota met: stop stepping the world
+        }
+    }
+    return ticks;
+}
+
+int main(int argc, char** argv) {
+    long          courses    = 1000000;
+    int           difficulty = -1;   // all
+    std::uint64_t seed       = 1;
+    int           hz         = 120;
+    HitboxMode    hitbox     = HitboxMode::BOX;
+    GapLayout     layout     = GapLayout::UNIFORM;
+    float         jitterMs   = 20.f;
+    int           cap        = 200;
+    unsigned      threads    = std::max(1u, std::thread::hardware_concurrency());
+    std::string   csvPath    = "survival.csv";
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if      (a == "--courses" && i + 1 < argc)    courses    = std::max(1L, std::atol(argv[++i]));
+        else if (a == "--difficulty" && i + 1 < argc) { std::string d = argv[++i];
+                                                        difficulty = d == "all" ? -1 : std::min(std::max(std::atoi(d.c_str()), 0), 2); }
+        else if (a == "--seed" && i + 1 < argc)       seed       = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--hz" && i + 1 < argc)         hz         = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--hitbox" && i + 1 < argc)     hitbox     = std::string(argv[++i]) == "hull" ? HitboxMode::HULL : HitboxMode::BOX;
+        else if (a == "--gaps" && i + 1 < argc)       layout     = std::string(argv[++i]) == "fair" ? GapLayout::FAIR : GapLayout::UNIFORM;
+        else if (a == "--jitter" && i + 1 < argc)     jitterMs   = std::max(0.f, static_cast<float>(std::atof(argv[++i])));
+        else if (a == "--cap" && i + 1 < argc)        cap        = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--threads" && i + 1 < argc)    threads    = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else if (a == "--csv" && i + 1 < argc)        csvPath    = argv[++i];
+    }
+    const float dt     = 1.f / static_cast<float>(hz);
+    const float jitter = jitterMs * 0.001f;
+    const long  perBlock = static_cast<long>(BLOCK_WORLDS) * BLOCK_EPISODES;
+    const long  blocks   = (courses + perBlock - 1) / perBlock;
+
+    std::vector<int> levels;
+    for (int d = 0; d <= 2; ++d)
+        if (difficulty < 0 || difficulty == d) levels.push_back(d);
+
+    static const char* NAMES[] = { "EASY", "NORMAL", "HARD" };
+    std::printf("%ld courses per difficulty  |  %d Hz, %s hitbox, %s gaps, %.0f ms jitter, cap %d  |  %u threads\n\n",
+                blocks * perBlock, hz, hitbox == HitboxMode::BOX ? "box" : "hull",
+                layout == GapLayout::FAIR ? "fair" : "uniform", jitterMs, cap, threads);
+
+    std::vector<Sweep> sweeps(levels.size());
+    for (std::size_t l = 0; l < levels.size(); ++l) {
+        Sweep& s = sweeps[l];
+        s.counts.assign(static_cast<std::size_t>(cap) + 1, 0);
+        s.courses = blocks * perBlock;
+        const Difficulty level = static_cast<Difficulty>(levels[l]);
+
+        std::atomic<long> next{ 0 };
+        std::mutex        merge;
+        auto worker = [&]() {
+            std::vector<std::uint64_t> counts(s.counts.size(), 0);
+            std::uint64_t ticks = 0;
+            for (long b = next++; b < blocks; b = next++)
+                ticks += playBlock(b, level, hitbox, layout, seed, dt, jitter, cap, counts);
+            std::lock_guard<std::mutex> g(merge);
+            for (std::size_t k = 0; k < counts.size(); ++k) s.counts[k] += counts[k];
+            s.ticks += ticks;
+        };
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+        for (auto& t : pool) t.join();
+        s.secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        double mean = 0.0;
+        std::uint64_t seen = 0;
+        int median = cap;
+        for (int k = 0; k <= cap; ++k) {
+            mean += static_cast<double>(k) * static_cast<double>(s.counts[static_cast<std::size_t>(k)]);
+            seen += s.counts[static_cast<std::size_t>(k)];
+            if (median == cap && seen * 2 >= static_cast<std::uint64_t>(s.courses)) median = k;
+        }
+        mean /= static_cast<double>(s.courses);
+        auto reach = [&](int n) {
+            std::uint64_t c = 0;
+            for (int k = std::min(n, cap); k <= cap; ++k) c += s.counts[static_cast<std::size_t>(k)];
+            return 100.0 * static_cast<double>(c) / static_cast<double>(s.courses);
+        };
+        std::printf("%-7s  mean %6.2f  median %3d  |  >=1 %5.1f%%  >=10 %5.1f%%  >=50 %5.1f%%  >=%d %5.2f%%"
+                    "  |  %.2f s  %.0f courses/s  %.3g steps/s\n",
+                    NAMES[levels[l]], mean, median, reach(1), reach(10), reach(50), cap, reach(cap),
+                    s.secs, static_cast<double>(s.courses) / s.secs, static_cast<double>(s.ticks) / s.secs);
+    }
+
+    std::FILE* f = std::fopen(csvPath.c_str(), "w");
+    if (!f) {
+        std::fprintf(stderr, "cannot write %s\n", csvPath.c_str());
+        return 2;
+    }
+    std::fprintf(f, "score");
+    for (int d : levels) std::fprintf(f, ",%s", NAMES[d]);
+    std::fprintf(f, "\n");
+    std::vector<std::uint64_t> tail(levels.size(), 0);
+    std::vector<std::string>   rows(static_cast<std::size_t>(cap) + 1);
+    for (int k = cap; k >= 0; --k) {   // P(score >= k) accumulates from the top
+        std::string row = std::to_string(k);
+        for (std::size_t l = 0; l < levels.size(); ++l) {
+            tail[l] += sweeps[l].counts[static_cast<std::size_t>(k)];
+            char cell[32];
+            std::snprintf(cell, sizeof(cell), ",%.6f",
+                          static_cast<double>(tail[l]) / static_cast<double>(sweeps[l].courses));
+            row += cell;
+        }
+        rows[static_cast<std::size_t>(k)] = row;
+    }
+    for (const std::string& row : rows) std::fprintf(f, "%s\n", row.c_str());
+    std::fclose(f);
+    std::printf("\nwrote %s\n", csvPath.c_str());
+    return 0;
+}
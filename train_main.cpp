@@ -0,0 +1,98 @@
+#include "Evolution.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+// Evolves Brain controllers headless, evaluating each generation across
+// all cores:
+//   FlappyTrain [--generations G] [--population N] [--episodes E]
+//               [--difficulty 0|1|2] [--hitbox box|hull] [--hz H] [--seed S]
+//               [--max-seconds T] [--threads T] [--checkpoint FILE]
+//               [--every K] [--resume]
+// --checkpoint saves the population every K generations (default 10) and
+// at the end; --resume continues from that file if it exists, with the
+// parameters stored in it. Results do not depend on --threads. How
+// throughput scales with --threads has only been checked on one core so
+// far, where extra threads just add WorkPool overhead.
+
+int main(int argc, char** argv) {
+    EvolutionParams params;
+    int         generations = 50;
+    unsigned    threads     = std::max(1u, std::thread::hardware_concurrency());
+    std::string checkpoint;
+    int         every       = 10;
+    bool        resume      = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if      (a == "--generations" && i + 1 < argc) generations          = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--population" && i + 1 < argc)  params.population    = std::max(2, std::atoi(argv[++i]));
+        else if (a == "--episodes" && i + 1 < argc)    params.episodes      = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--difficulty" && i + 1 < argc)  params.difficulty    = static_cast<Difficulty>(std::min(std::max(std::atoi(argv[++i]), 0), 2));
+        else if (a == "--hitbox" && i + 1 < argc)      params.hitbox        = std::string(argv[++i]) == "hull" ? HitboxMode::HULL : HitboxMode::BOX;
+        else if (a == "--hz" && i + 1 < argc)          params.tickRate      = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--seed" && i + 1 < argc)        params.seed          = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--max-seconds" && i + 1 < argc) params.maxSeconds    = static_cast<float>(std::atof(argv[++i]));
+        else if (a == "--threads" && i + 1 < argc)     threads              = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else if (a == "--checkpoint" && i + 1 < argc)  checkpoint           = argv[++i];
+        else if (a == "--every" && i + 1 < argc)       every                = std::max(1, std::atoi(argv[++i]));
+        else if (a == "--resume")                      resume               = true;
+    }
+
+    Population pop(params);
+    std::error_code ec;
+    if (resume && !checkpoint.empty() && std::filesystem::exists(checkpoint, ec)) {
+        if (!pop.load(checkpoint)) {
+            std::fprintf(stderr, "cannot resume from %s\n", checkpoint.c_str());
+            return 2;
+        }
+        std::printf("resumed %s at generation %d\n", checkpoint.c_str(), pop.getGeneration());
+    } else {
+        pop.randomize();
+    }
+    const EvolutionParams& p = pop.getParams();
+
+    static const char* NAMES[] = { "EASY", "NORMAL", "HARD" };
+    std::printf("%d genomes x %d episodes  |  %s, %d Hz, %s hitbox, %.0f s cap  |  %u threads, %s forward pass\n\n",
+                p.population, p.episodes, NAMES[static_cast<int>(p.difficulty)], p.tickRate,
+                p.hitbox == HitboxMode::BOX ? "box" : "hull", p.maxSeconds, threads,
+                Brain::simdAvailable() ? "AVX2" : "scalar");
+
+    WorkPool pool(threads);
+    std::uint64_t episodes = 0, ticks = 0;
+    const int last = pop.getGeneration() + generations;
+    auto t0 = std::chrono::steady_clock::now();
+    while (pop.getGeneration() < last) {
+        auto g0 = std::chrono::steady_clock::now();
+        pop.evaluate(pool);
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - g0).count();
+
+        std::uint64_t genTicks = 0;
+        for (int i = 0; i < pop.size(); ++i) genTicks += pop.getEvaluation(i).ticks;
+        const int evals = pop.size() * p.episodes;
+        episodes += static_cast<std::uint64_t>(evals);
+        ticks    += genTicks;
+
+        const Evaluation& best = pop.getEvaluation(pop.getBestIndex());
+        std::printf("gen %4d  best %7.2f (score %3d)  mean %7.2f  |  %6.0f evals/s  %.3g ticks/s\n",
+                    pop.getGeneration(), best.fitness, best.bestScore, pop.getMeanFitness(),
+                    static_cast<double>(evals) / secs, static_cast<double>(genTicks) / secs);
+
+        pop.breed();
+        if (!checkpoint.empty() && (pop.getGeneration() % every == 0 || pop.getGeneration() == last)) {
+            if (!pop.save(checkpoint))
+                std::fprintf(stderr, "cannot write checkpoint %s\n", checkpoint.c_str());
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::printf("\nchampion    : fitness %.2f\n", pop.getChampionFitness());
+    std::printf("%d generations  |  %.3f s  |  %.2f gen/s  |  %.0f evals/s  |  %.3g ticks/s  |  %llu steals\n",
+                generations, secs, static_cast<double>(generations) / secs,
+                static_cast<double>(episodes) / secs, static_cast<double>(ticks) / secs,
+                static_cast<unsigned long long>(pool.getSteals()));
+    return 0;
+}
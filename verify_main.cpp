@@ -0,0 +1,165 @@
+#include "Replay.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Re-simulates every .fbr replay in a directory and checks the claimed score:
+//   FlappyVerify <replay-dir> [--threads N] [--quiet] [--hashes FILE] [--compare FILE]
+// --hashes writes one line per replay with a hash of its tick-by-tick
+// state; --compare checks those hashes against a file written by another
+// build, so a build that drifts by one bit on any tick fails even if the
+// score happens to come out the same. Only bit-exact replays (Fixed
+// physics, BOX hitbox, uniform gaps; see Replay::isBitExact) are expected
+// to match across builds: the others are flagged when their hash differs,
+// but only fail on their score. Under --compare a bit-exact replay with no
+// reference hash fails, and so does a reference entry with no replay.
+// Exit code is 0 only if at least one replay was found and every one passes.
+
+namespace fs = std::filesystem;
+
+struct VerifyJob {
+    std::string   path;
+    bool          loaded;
+    Replay        replay;
+    ReplayResult  result;
+    std::string   error;    // the simulation threw; the file fails on its own
+};
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <replay-dir> [--threads N] [--quiet] [--hashes FILE] [--compare FILE]\n", argv[0]);
+        return 2;
+    }
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool     quiet   = false;
+    std::string hashPath, comparePath;
+    for (int i = 2; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--threads" && i + 1 < argc) threads = static_cast<unsigned>(std::max(1, std::atoi(argv[++i])));
+        else if (a == "--quiet")              quiet   = true;
+        else if (a == "--hashes" && i + 1 < argc)  hashPath    = argv[++i];
+        else if (a == "--compare" && i + 1 < argc) comparePath = argv[++i];
+    }
+    const bool hashStates = !hashPath.empty() || !comparePath.empty();
+
+    // Reference hashes by file name: "name score ticks hash" per line
+    std::map<std::string, std::uint64_t> reference;
+    if (!comparePath.empty()) {
+        std::FILE* f = std::fopen(comparePath.c_str(), "r");
+        if (!f) { std::fprintf(stderr, "cannot read %s\n", comparePath.c_str()); return 2; }
+        char name[512];
+        int score;
+        unsigned ticks;
+        unsigned long long hash;
+        while (std::fscanf(f, "%511s %d %u %llx", name, &score, &ticks, &hash) == 4)
+            reference[name] = hash;
+        std::fclose(f);
+    }
+
+    std::vector<VerifyJob> jobs;
+    std::error_code ec;
+    for (const auto& e : fs::directory_iterator(argv[1], ec))
+        if (e.is_regular_file() && e.path().extension() == ".fbr")
+            jobs.push_back(VerifyJob{ e.path().string(), false, Replay(), ReplayResult{ 0, 0, 0 }, std::string() });
+    if (ec) { std::fprintf(stderr, "cannot read %s: %s\n", argv[1], ec.message().c_str()); return 2; }
+    if (jobs.empty()) { std::fprintf(stderr, "no .fbr replays in %s\n", argv[1]); return 2; }
+    std::sort(jobs.begin(), jobs.end(),
+        [](const VerifyJob& a, const VerifyJob& b){ return a.path < b.path; });
+
+    // Work queue: workers claim the next file index until the list is drained
+    std::atomic<std::size_t>   next{ 0 };
+    std::atomic<std::uint64_t> ticks{ 0 };
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < jobs.size(); i = next++) {
+            VerifyJob& job = jobs[i];
+            job.loaded = job.replay.load(job.path);
+            if (!job.loaded) continue;
+            try {
+                job.result = simulateReplay(job.replay, hashStates);
+            } catch (const std::exception& e) {
+                job.error = e.what();
+                continue;
+            }
+            ticks += job.result.ticks;
+        }
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) pool.emplace_back(worker);
+    for (auto& t : pool) t.join();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    const bool comparing = !comparePath.empty();
+    std::size_t passed = 0, drifted = 0, floatDrifted = 0, compared = 0, unhashed = 0;
+    std::map<std::string, bool> seen;   // reference entries that have a replay here
+    for (const auto& job : jobs) {
+        const std::string name = fs::path(job.path).filename().string();
+        auto ref = reference.find(name);
+        if (ref != reference.end()) seen[name] = true;
+        const bool ran     = job.loaded && job.error.empty();
+        const bool hashed  = ran && ref != reference.end();
+        const bool differs = hashed && ref->second != job.result.hash;
+        const bool drift   = differs && job.replay.isBitExact();
+        // A bit-exact replay the other build never hashed was not checked
+        const bool missing = comparing && ran && !hashed && job.replay.isBitExact();
+        bool ok = ran && job.result.matches(job.replay) && !drift && !missing;
+        if (ok) ++passed;
+        if (hashed) ++compared;
+        if (drift) ++drifted;
+        if (differs && !drift) ++floatDrifted;
+        if (missing) ++unhashed;
+        if (quiet && ok && !differs) continue;
+        if (!job.loaded)
+            std::printf("FAIL  %s  unreadable replay\n", job.path.c_str());
+        else if (!job.error.empty())
+            std::printf("FAIL  %s  simulation failed: %s\n", job.path.c_str(), job.error.c_str());
+        else
+            std::printf("%s  %s  claimed %u/%u  simulated %d/%u (score/ticks)%s\n",
+                        ok ? "PASS" : "FAIL", job.path.c_str(),
+                        job.replay.score, job.replay.tickCount,
+                        job.result.score, job.result.ticks,
+                        drift ? "  state hash differs" : differs ? "  state hash differs (not bit-exact)"
+                              : missing ? "  no reference hash" : "");
+    }
+
+    if (!hashPath.empty()) {
+        std::FILE* f = std::fopen(hashPath.c_str(), "w");
+        if (!f) { std::fprintf(stderr, "cannot write %s\n", hashPath.c_str()); return 2; }
+        for (const auto& job : jobs)
+            if (job.loaded && job.error.empty())
+                std::fprintf(f, "%s %d %u %016llx\n", fs::path(job.path).filename().string().c_str(),
+                             job.result.score, job.result.ticks, static_cast<unsigned long long>(job.result.hash));
+        std::fclose(f);
+    }
+    std::size_t orphans = 0;
+    if (comparing) {
+        for (const auto& ref : reference) {
+            if (seen.count(ref.first)) continue;
+            std::printf("FAIL  %s  in %s but not in %s\n", ref.first.c_str(), comparePath.c_str(), argv[1]);
+            ++orphans;
+        }
+        std::printf("\nstate hashes: %zu of %zu compared replays differ from %s\n", drifted + floatDrifted,
+                    compared, comparePath.c_str());
+        if (floatDrifted > 0)
+            std::printf("              %zu of them are not bit-exact (float physics, hull hitbox or fair gaps)\n",
+                        floatDrifted);
+        if (unhashed > 0)
+            std::printf("              %zu bit-exact replays have no reference hash\n", unhashed);
+        if (orphans > 0)
+            std::printf("              %zu reference entries have no replay\n", orphans);
+    }
+
+    std::printf("\n%zu/%zu passed  |  %u threads  |  %.3f s\n", passed, jobs.size(), threads, secs);
+    if (secs > 0.0)
+        std::printf("throughput: %.1f replays/s, %.3g ticks/s\n",
+                    jobs.size() / secs, static_cast<double>(ticks.load()) / secs);
+    return passed == jobs.size() && orphans == 0 ? 0 : 1;
+}